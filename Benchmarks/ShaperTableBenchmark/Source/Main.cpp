@@ -0,0 +1,134 @@
+#include <JuceHeader.h>
+#include "../../../Source/src/dsp/ShaperTable.h"
+#include "../../../Source/src/dsp/ShaperCurve.h"
+#include "../../../Source/src/dsp/VectorKernels.h"
+
+#include <chrono>
+#include <iostream>
+
+// Accuracy and speed of the lookup-table shaper against the exact curve.
+//
+// For every kernel set the CPU can run, the driven signal sweeps -drive..drive
+// for drive 1..20 and saturation 0..1 (in steps that also land between table
+// slices). The error is taken against ShaperCurve<double>; the timing compares
+// ShaperTable::process with the exact shape kernel over the same blocks.
+// Returns non-zero if the table error goes past ShaperTable::maxError.
+
+namespace
+{
+    constexpr int blockSize = 512;
+    constexpr int numDriveSteps = 39;        // 1 to 20 in steps of 0.5
+    constexpr int numSaturationSteps = 101;  // 0 to 1 in steps of 0.01
+    constexpr int timingRepeats = 20;
+
+    double getDrive(int step) noexcept          { return 1.0 + 0.5 * step; }
+    double getSaturation(int step) noexcept     { return (double)step / (double)(numSaturationSteps - 1); }
+
+    // One block of an input ramp from -1 to 1, times drive
+    template <typename SampleType>
+    void fillDriven(SampleType* data, double drive) noexcept
+    {
+        for (int i = 0; i < blockSize; ++i)
+            data[i] = (SampleType)(drive * (2.0 * i / (double)(blockSize - 1) - 1.0));
+    }
+
+    struct Result
+    {
+        double maxError = 0.0;
+        double rmsError = 0.0;
+        double tableNanoseconds = 0.0;   // Per sample
+        double exactNanoseconds = 0.0;
+    };
+
+    template <typename SampleType>
+    Result measure(const ShaperTable& table, const VectorKernels::Table<SampleType>& kernels)
+    {
+        Result result;
+        double squaredErrorSum = 0.0;
+        std::vector<SampleType> driven((size_t)blockSize), block((size_t)blockSize);
+
+        for (int d = 0; d < numDriveSteps; ++d)
+        {
+            fillDriven(driven.data(), getDrive(d));
+
+            for (int s = 0; s < numSaturationSteps; ++s)
+            {
+                const ShaperCurve<double> exact(getSaturation(s));
+
+                block = driven;
+                table.process(block.data(), blockSize, (float)getSaturation(s), kernels);
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    const double error = std::abs((double)block[(size_t)i] - exact((double)driven[(size_t)i]));
+                    result.maxError = juce::jmax(result.maxError, error);
+                    squaredErrorSum += error * error;
+                }
+            }
+        }
+
+        result.rmsError = std::sqrt(squaredErrorSum / ((double)numDriveSteps * numSaturationSteps * blockSize));
+
+        const double samplesTimed = (double)timingRepeats * numDriveSteps * numSaturationSteps * blockSize;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int r = 0; r < timingRepeats; ++r)
+            for (int d = 0; d < numDriveSteps; ++d)
+                for (int s = 0; s < numSaturationSteps; ++s)
+                {
+                    fillDriven(block.data(), getDrive(d));
+                    table.process(block.data(), blockSize, (float)getSaturation(s), kernels);
+                }
+
+        auto end = std::chrono::steady_clock::now();
+        result.tableNanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / samplesTimed;
+
+        start = std::chrono::steady_clock::now();
+
+        for (int r = 0; r < timingRepeats; ++r)
+            for (int d = 0; d < numDriveSteps; ++d)
+                for (int s = 0; s < numSaturationSteps; ++s)
+                {
+                    fillDriven(block.data(), getDrive(d));
+                    kernels.shape(block.data(), blockSize, ShaperCurve<SampleType>((SampleType)getSaturation(s)));
+                }
+
+        end = std::chrono::steady_clock::now();
+        result.exactNanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / samplesTimed;
+
+        return result;
+    }
+
+    template <typename SampleType>
+    bool report(const ShaperTable& table, VectorKernels::InstructionSet set, const char* typeName)
+    {
+        const auto result = measure(table, VectorKernels::get<SampleType>(set));
+        const bool passed = result.maxError <= (double)ShaperTable::maxError;
+
+        std::cout << VectorKernels::getName(set) << " " << typeName
+                  << ": max error " << result.maxError
+                  << ", RMS error " << result.rmsError
+                  << ", table " << result.tableNanoseconds << " ns/sample"
+                  << ", exact " << result.exactNanoseconds << " ns/sample"
+                  << (passed ? "" : "  FAILED") << std::endl;
+
+        return passed;
+    }
+}
+
+int main()
+{
+    juce::SharedResourcePointer<ShaperTable> table;
+    bool passed = true;
+
+    const auto detected = VectorKernels::getDetectedInstructionSet();
+
+    for (int set = 0; set <= (int)detected; ++set)
+    {
+        passed = report<float>(*table, (VectorKernels::InstructionSet)set, "float") && passed;
+        passed = report<double>(*table, (VectorKernels::InstructionSet)set, "double") && passed;
+    }
+
+    return passed ? 0 : 1;
+}
@@ -73,7 +73,8 @@ juce::Font AntsDistSatLookAndFeel::getLabelFont(juce::Label& /*label*/)
 
 // Editor implementation
 AntsDistSatAudioProcessorEditor::AntsDistSatAudioProcessorEditor(AntsDistSatAudioProcessor& p)
-    : AudioProcessorEditor(&p), audioProcessor(p)
+    : AudioProcessorEditor(&p), audioProcessor(p),
+      frameClock(this, [this](double timestampSeconds) { advanceFrame(timestampSeconds); })
 {
     // Create main component
     mainComponent.reset(new MainComponent(audioProcessor, audioProcessor.getValueTreeState()));
@@ -84,14 +85,14 @@ AntsDistSatAudioProcessorEditor::AntsDistSatAudioProcessorEditor(AntsDistSatAudi
     // = 32 + 4 + 8 + 300 + 24 + 8 + 24 = 400px height
     // Width: border(24) + padding(16) + max row width (4 knobs = 280 + 24 gaps = 304) = 344px, round to 400 for header
     setSize(400, 400);
-    
-    // Start timer for visualizer updates
-    startTimerHz(25);
+
+    updateAnalysisState();
 }
 
 AntsDistSatAudioProcessorEditor::~AntsDistSatAudioProcessorEditor()
 {
-    stopTimer();
+    if (analysisRunning)
+        audioProcessor.getSpectrumAnalyzer().stop();
 }
 
 void AntsDistSatAudioProcessorEditor::paint(juce::Graphics& g)
@@ -106,15 +107,57 @@ void AntsDistSatAudioProcessorEditor::resized()
     mainComponent->setBounds(getLocalBounds());
 }
 
-void AntsDistSatAudioProcessorEditor::timerCallback()
+void AntsDistSatAudioProcessorEditor::visibilityChanged()
 {
-    // Update visualizer with audio buffer data
-    if (mainComponent != nullptr)
-    {
-        mainComponent->updateVisualizer(
-            audioProcessor.getAudioBufferForSpectrogram(),
-            audioProcessor.getNumSpectrumSamples());
-    }
+    updateAnalysisState();
+}
+
+void AntsDistSatAudioProcessorEditor::parentHierarchyChanged()
+{
+    // Also covers the editor gaining or losing its window
+    updateAnalysisState();
+}
+
+void AntsDistSatAudioProcessorEditor::minimisationStateChanged(bool /*isNowMinimised*/)
+{
+    updateAnalysisState();
+}
+
+void AntsDistSatAudioProcessorEditor::updateAnalysisState()
+{
+    // Hidden, minimised or detached: the vertical blank stops with the window,
+    // so the analysis is switched here rather than from the frame clock
+    const bool showing = mainComponent != nullptr && isShowing();
+
+    if (showing == analysisRunning)
+        return;
+
+    analysisRunning = showing;
+
+    if (analysisRunning)
+        audioProcessor.getSpectrumAnalyzer().start();
+    else
+        audioProcessor.getSpectrumAnalyzer().stop();
+}
+
+void AntsDistSatAudioProcessorEditor::advanceFrame(double timestampSeconds)
+{
+    // Cheap when nothing has changed; catches a host that shows the window
+    // without telling the editor
+    updateAnalysisState();
+
+    if (! analysisRunning)
+        return;
+
+    // The vertical blank may be 60, 120 or 144 Hz; only act on the frames we
+    // want, allowing for a little jitter in the timestamps
+    if (timestampSeconds - lastFrameTime < frameInterval - frameTolerance)
+        return;
+
+    lastFrameTime = timestampSeconds;
+
+    const bool newData = mainComponent->updateVisualizer(audioProcessor.getSpectrumAnalyzer());
+    frameInterval = 1.0 / (newData ? activeFrameRate : idleFrameRate);
 }
 
 // Keep your other existing methods
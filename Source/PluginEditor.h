@@ -27,8 +27,7 @@ private:
 };
 
 class AntsDistSatAudioProcessorEditor : public juce::AudioProcessorEditor,
-                                        private juce::Slider::Listener,
-                                        private juce::Timer
+                                        private juce::Slider::Listener
 {
 public:
     AntsDistSatAudioProcessorEditor(AntsDistSatAudioProcessor&);
@@ -36,13 +35,17 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+    void minimisationStateChanged(bool isNowMinimised) override;
     
     // Add getter for MainComponent
     MainComponent* getMainComponent() { return mainComponent.get(); }
 
 private:
     void sliderValueChanged(juce::Slider* slider) override;
-    void timerCallback() override;
+    void advanceFrame(double timestampSeconds);
+    void updateAnalysisState();
     void updateValueLabels();
     void drawReactiveBackground(juce::Graphics& g);
 
@@ -110,5 +113,18 @@ private:
     // Main component that contains all UI elements
     std::unique_ptr<MainComponent> mainComponent;
 
+    // The editor's only frame clock, driven by the display's vertical blank.
+    // It runs at up to activeFrameRate while new spectrum data is arriving
+    // and drops to idleFrameRate when it is not.
+    static constexpr double activeFrameRate = 60.0;
+    static constexpr double idleFrameRate = 20.0;
+    static constexpr double frameTolerance = 0.002;
+    double frameInterval = 1.0 / idleFrameRate;
+    double lastFrameTime = 0.0;
+    juce::VBlankAttachment frameClock;
+
+    // The analysis only runs while the editor is on screen
+    bool analysisRunning = false;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AntsDistSatAudioProcessorEditor)
 };
\ No newline at end of file
@@ -15,10 +15,7 @@ AntsDistSatAudioProcessor::AntsDistSatAudioProcessor()
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
-                       ),
-    forwardFFT(10),  // 2^10 = 1024 points
-    inverseFFT(10),
-    window(1024, juce::dsp::WindowingFunction<float>::hann)
+                       )
 #endif
 {
     // Create value tree state for parameter management (this creates and owns the parameters)
@@ -28,14 +25,32 @@ AntsDistSatAudioProcessor::AntsDistSatAudioProcessor()
     layout.add(std::make_unique<juce::AudioParameterFloat>("mix", "Mix", 0.0f, 1.0f, 0.5f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("saturation", "Saturation", 0.0f, 1.0f, 0.7f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("midside", "Mid/Side", 0.0f, 1.0f, 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("mspairs", "Mid/Side Pairs",
+                                                            juce::StringArray { "Off", "Front", "All Pairs" }, 1));
     layout.add(std::make_unique<juce::AudioParameterFloat>("threshold", "Threshold", -60.0f, 0.0f, -40.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("attack", "Attack", 0.1f, 100.0f, 10.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("release", "Release", 1.0f, 500.0f, 100.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("bitcrush", "Bit Crush", 1.0f, 16.0f, 16.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("bitmodulation", "Bit Modulation", 0.0f, 1.0f, 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("bitmodrate", "Bit Mod Rate",
+                                                           juce::NormalisableRange<float>(0.1f, 2000.0f, 0.0f, 0.25f), 700.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("bitmodshape", "Bit Mod Shape",
+                                                            juce::StringArray { "Sine", "Triangle", "Saw", "Square" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterBool>("bitmodsync", "Bit Mod Sync", false));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("bitmodnote", "Bit Mod Note",
+                                                            juce::StringArray { "1/1", "1/2", "1/4", "1/8", "1/16", "1/32", "1/64" }, 4));
     layout.add(std::make_unique<juce::AudioParameterFloat>("downsample", "Downsample", 1.0f, 50.0f, 1.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("jitter", "Jitter", 0.0f, 1.0f, 0.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("spectralshift", "Spectral Shift", -1.0f, 1.0f, 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("oversampling", "Oversampling",
+                                                            juce::StringArray { "1x", "2x", "4x", "8x", "16x" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("osfilter", "Oversampling Filter",
+                                                            juce::StringArray { "Min Phase IIR", "Linear Phase FIR" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("shapermode", "Shaper Mode",
+                                                            juce::StringArray { "Direct", "ADAA 1st Order", "ADAA 2nd Order", "Lookup Table" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("spectralmode", "Spectral Mode",
+                                                            juce::StringArray { "Frequency Shifter", "STFT Bin Shift" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterBool>("deterministicjitter", "Deterministic Jitter", false));
     
     valueTreeState = std::make_unique<juce::AudioProcessorValueTreeState>(*this, nullptr, "Parameters", std::move(layout));
     
@@ -44,20 +59,30 @@ AntsDistSatAudioProcessor::AntsDistSatAudioProcessor()
     mixParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("mix"));
     saturationParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("saturation"));
     midSideParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("midside"));
+    midSidePairsParam = dynamic_cast<juce::AudioParameterChoice*>(valueTreeState->getParameter("mspairs"));
     thresholdParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("threshold"));
     attackParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("attack"));
     releaseParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("release"));
     bitCrushParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("bitcrush"));
     bitModulationParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("bitmodulation"));
+    bitModulationRateParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("bitmodrate"));
+    bitModulationShapeParam = dynamic_cast<juce::AudioParameterChoice*>(valueTreeState->getParameter("bitmodshape"));
+    bitModulationSyncParam = dynamic_cast<juce::AudioParameterBool*>(valueTreeState->getParameter("bitmodsync"));
+    bitModulationNoteParam = dynamic_cast<juce::AudioParameterChoice*>(valueTreeState->getParameter("bitmodnote"));
     downsampleParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("downsample"));
     jitterParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("jitter"));
     spectralShiftParam = dynamic_cast<juce::AudioParameterFloat*>(valueTreeState->getParameter("spectralshift"));
+    oversamplingParam = dynamic_cast<juce::AudioParameterChoice*>(valueTreeState->getParameter("oversampling"));
+    oversamplingFilterParam = dynamic_cast<juce::AudioParameterChoice*>(valueTreeState->getParameter("osfilter"));
+    shaperModeParam = dynamic_cast<juce::AudioParameterChoice*>(valueTreeState->getParameter("shapermode"));
+    spectralModeParam = dynamic_cast<juce::AudioParameterChoice*>(valueTreeState->getParameter("spectralmode"));
+    deterministicJitterParam = dynamic_cast<juce::AudioParameterBool*>(valueTreeState->getParameter("deterministicjitter"));
 
-    spectrogramBuffer.setSize(1, spectrogramBufferSize);
-    fftBuffer.setSize(1, 1024);
-    fftData.resize(1024);
-    bitCrushBuffer.resize(1024);
-    modulationBuffer.resize(1024);
+    parameterSnapshot = std::make_unique<ParameterSnapshot>(*valueTreeState);
+
+    // Every instance gets its own jitter seed, saved with the project
+    jitterSeed = (juce::uint32)juce::Random::getSystemRandom().nextInt();
+    parameterSnapshot->setJitterSeed(jitterSeed);
 }
 
 
@@ -71,9 +96,35 @@ const juce::String AntsDistSatAudioProcessor::getName() const
 
 void AntsDistSatAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialization that you need..
-    juce::ignoreUnused(sampleRate, samplesPerBlock);
+    // Without deterministic jitter each run gets fresh noise
+    freeRunningSeed = (juce::uint32)juce::Random::getSystemRandom().nextInt();
+
+    parameterSnapshot->prepare(sampleRate);
+    parameterSnapshot->update();
+
+    analysisFifo.prepare((int)std::ceil(sampleRate * analysisFifoSeconds));
+    spectrumAnalyzer.setSampleRate(sampleRate);
+
+    // All scratch memory for the block engine is allocated here, never on the
+    // audio thread. The host sets the precision and the layout before calling
+    // this; the block size does not matter, as the engine splits blocks into chunks.
+    juce::ignoreUnused(samplesPerBlock);
+    const auto layout = getChannelLayoutOfBus(true, 0);
+
+    if (isUsingDoublePrecision())
+    {
+        doubleEngine.setOfflineRendering(isNonRealtime());
+        doubleEngine.prepare(sampleRate, layout);
+        updateNoiseSeed(doubleEngine);
+        updateLatency(doubleEngine);
+    }
+    else
+    {
+        engine.setOfflineRendering(isNonRealtime());
+        engine.prepare(sampleRate, layout);
+        updateNoiseSeed(engine);
+        updateLatency(engine);
+    }
 }
 
 void AntsDistSatAudioProcessor::releaseResources()
@@ -84,10 +135,11 @@ void AntsDistSatAudioProcessor::releaseResources()
 
 bool AntsDistSatAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every stage runs per channel and the Mid/Side pairs come from the
+    // layout, so any layout works, discrete, surround or ambisonic
+    const auto output = layouts.getMainOutputChannelSet();
+
+    if (output.isDisabled() || output.size() > DistortionEngineBase::maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -126,7 +178,11 @@ bool AntsDistSatAudioProcessor::isMidiEffect() const
 
 double AntsDistSatAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // Latency plus filter ringing, so hosts know when the plugin can sleep. The
+    // engines publish it atomically, since hosts ask from any thread.
+    const double sampleRate = getSampleRate();
+    const int tailSamples = isUsingDoublePrecision() ? doubleEngine.getTailLengthInSamples() : engine.getTailLengthInSamples();
+    return sampleRate > 0.0 ? tailSamples / sampleRate : 0.0;
 }
 
 int AntsDistSatAudioProcessor::getNumPrograms()
@@ -156,223 +212,93 @@ void AntsDistSatAudioProcessor::changeProgramName(int index, const juce::String&
     juce::ignoreUnused(index, newName);
 }
 
-void AntsDistSatAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ignoreUnused(midiMessages);
-
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, buffer.getNumSamples());
-
-    // Read parameters from ValueTreeState (the ones the UI controls)
-    float drive = valueTreeState->getRawParameterValue("drive")->load();
-    float mix = valueTreeState->getRawParameterValue("mix")->load();
-    float saturation = valueTreeState->getRawParameterValue("saturation")->load();
-    float midSide = valueTreeState->getRawParameterValue("midside")->load();
-    float threshold = juce::Decibels::decibelsToGain(valueTreeState->getRawParameterValue("threshold")->load());
-    float attack = valueTreeState->getRawParameterValue("attack")->load();
-    float release = valueTreeState->getRawParameterValue("release")->load();
-    float bitCrushAmount = valueTreeState->getRawParameterValue("bitcrush")->load();
-    float bitModulation = valueTreeState->getRawParameterValue("bitmodulation")->load();
-    float downsample = valueTreeState->getRawParameterValue("downsample")->load();
-    float jitter = valueTreeState->getRawParameterValue("jitter")->load();
-    float spectralShift = valueTreeState->getRawParameterValue("spectralshift")->load();
-
-    attackCoeff = static_cast<float>(std::exp(-1.0 / (getSampleRate() * attack * 0.001f)));
-    releaseCoeff = static_cast<float>(std::exp(-1.0 / (getSampleRate() * release * 0.001f)));
-
-    if (totalNumInputChannels >= 2)
-    {
-        midSideEncode(buffer);
-        processMidSide(buffer, midSide);
-    }
-
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    { 
-        auto* channelData = buffer.getWritePointer(channel);
-        
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            float cleanSample = channelData[i];
-            float currentEnvelope = envelopeFollower(std::abs(cleanSample), attack, release);
-            cleanSample = noiseGate(cleanSample, threshold, currentEnvelope);
-
-            // Get the distorted version
-            float distortedSample = processSample(cleanSample, drive, saturation);
-            
-            // Apply bit crushing to the raw sample
-            float crushedSample = bitCrush(cleanSample, bitCrushAmount, bitModulation, spectralShift, downsample, jitter);
-            
-            // Mix clean, distorted and bit-crushed signals
-            channelData[i] = cleanSample * (1.0f - mix) + (distortedSample + crushedSample) * mix * 0.5f;
-        }
-    }
-
-    if (totalNumInputChannels >= 2)
-    {
-        midSideDecode(buffer);
-    }
-
-    // Update spectrogram (if needed)
-    if (buffer.getNumChannels() > 0)
-    {
-        spectrogramBuffer.clear();
-        spectrogramBuffer.copyFrom(0, 0, buffer.getReadPointer(0), 
-                                 std::min(buffer.getNumSamples(), spectrogramBuffer.getNumSamples()));
-    }
-}
-void AntsDistSatAudioProcessor::midSideEncode(juce::AudioBuffer<float>& buffer)
+bool AntsDistSatAudioProcessor::supportsDoublePrecisionProcessing() const
 {
-    auto* leftChannel = buffer.getWritePointer(0);
-    auto* rightChannel = buffer.getWritePointer(1);
-
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-    {
-        float mid = (leftChannel[sample] + rightChannel[sample]) * 0.5f;
-        float side = (leftChannel[sample] - rightChannel[sample]) * 0.5f;
-
-        leftChannel[sample] = mid;
-        rightChannel[sample] = side;
-    }
+    return true;
 }
 
-void AntsDistSatAudioProcessor::midSideDecode(juce::AudioBuffer<float>& buffer)
+void AntsDistSatAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    auto* midChannel = buffer.getWritePointer(0);
-    auto* sideChannel = buffer.getWritePointer(1);
-
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-    {
-        float left = midChannel[sample] + sideChannel[sample];
-        float right = midChannel[sample] - sideChannel[sample];
-
-        midChannel[sample] = left;
-        sideChannel[sample] = right;
-    }
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer, engine);
 }
 
-void AntsDistSatAudioProcessor::processMidSide(juce::AudioBuffer<float>& buffer, float midSideRatio)
+void AntsDistSatAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
 {
-    auto* midChannel = buffer.getWritePointer(0);
-    auto* sideChannel = buffer.getWritePointer(1);
-
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-    {
-        midChannel[sample] *= (1.0f - midSideRatio);
-        sideChannel[sample] *= midSideRatio;
-    }
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer, doubleEngine);
 }
 
-float AntsDistSatAudioProcessor::processSample(float sample, float drive, float saturation)
+template <typename SampleType>
+void AntsDistSatAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer, DistortionEngine<SampleType>& activeEngine)
 {
-    // Apply drive (pre-gain stage)
-    sample *= drive;
-    float cleanSample = sample;
-
-    // Oversampling to reduce aliasing (process in higher resolution)
-    constexpr int oversampleFactor = 4;
-    float oversampled = sample;
-    for (int i = 0; i < oversampleFactor; ++i)
-    {
-        oversampled *= 0.5f; // soft gain control during oversampling
-    }
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-    // Non-linear soft clipping - using a more complex curve for better character
-    float clippedSample = std::tanh(oversampled * (1.0f + saturation * 4.0f)) +
-                          0.3f * std::pow(oversampled, 3) - 
-                          0.1f * std::pow(oversampled, 5);
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Enhanced harmonic generation using polynomial waveshaping for harmonics
-    float harmonic2 = std::sin(sample * M_PI * 2.0f) * 0.12f * saturation;
-    float harmonic3 = std::sin(sample * M_PI * 3.0f) * 0.07f * saturation;
-    float harmonic4 = std::sin(sample * M_PI * 4.0f) * 0.03f * saturation;
+    // Only reloads (and re-derives coefficients) when a parameter has moved
+    const auto& params = parameterSnapshot->update();
 
-    float distortedSample = clippedSample + harmonic2 + harmonic3 + harmonic4;
+    updateNoiseSeed(activeEngine);
+    updateLatency(activeEngine);
 
-    // New waveshaping function for more aggressive shaping
-    distortedSample = (distortedSample * (1.0f + saturation * 0.5f)) / 
-                      (1.0f + std::abs(distortedSample * saturation * 3.0f));
+    // Tempo and position for the synced Bit Modulation LFO
+    double bpm = 120.0;
+    double ppqPosition = 0.0;
+    bool isPlaying = false;
 
-    // Anti-aliasing step after distortion processing (downsample)
-    for (int i = 0; i < oversampleFactor; ++i)
+    if (auto* playHead = getPlayHead())
     {
-        distortedSample *= 2.0f; // undo gain control from oversampling
-    }
+        if (auto position = playHead->getPosition())
+        {
+            bpm = position->getBpm().orFallback(bpm);
 
-    // Final mix of clean and distorted signal, with dynamic saturation control
-    return (1.0f - saturation) * cleanSample + saturation * distortedSample;
-}
+            if (auto ppq = position->getPpqPosition())
+            {
+                ppqPosition = *ppq;
+                isPlaying = position->getIsPlaying();
+            }
+        }
+    }
 
+    activeEngine.setTransport(bpm, ppqPosition, isPlaying);
+    activeEngine.process(buffer, totalNumInputChannels, params);
 
-float AntsDistSatAudioProcessor::envelopeFollower(float input, float /*attack*/, float /*release*/)
-{
-    float coeff = (input > envelope) ? attackCoeff : releaseCoeff;
-    envelope = input + coeff * (envelope - input);
-    return envelope;
+    // Hand the output to the visualiser; never blocks, drops samples if the reader falls behind
+    if (buffer.getNumChannels() > 0)
+        analysisFifo.push(buffer.getReadPointer(0), buffer.getNumSamples());
 }
 
-float AntsDistSatAudioProcessor::noiseGate(float input, float threshold, float currentEnvelope)
+template <typename SampleType>
+void AntsDistSatAudioProcessor::updateLatency(DistortionEngine<SampleType>& activeEngine)
 {
-    float gateGain = (currentEnvelope > threshold) ? 1.0f : 0.0f;
-    return input * gateGain;
+    // Every factor is pre-built by the engine, so this only switches pointers.
+    // Offline bounces render at the highest factor; hosts normally switch
+    // before prepareToPlay, so the new latency is known before the render.
+    activeEngine.setOfflineRendering(isNonRealtime());
+    activeEngine.setOversampling(parameterSnapshot->getOversamplingOrder(), parameterSnapshot->isLinearPhaseOversampling());
+    activeEngine.setSpectralMode(parameterSnapshot->getSpectralMode());
+
+    if (activeEngine.getLatencyInSamples() != getLatencySamples())
+        setLatencySamples(activeEngine.getLatencyInSamples());
 }
 
-float AntsDistSatAudioProcessor::bitCrush(float sample, float bitDepth, float bitModulation, float spectralShift, float downsample, float jitter)
+template <typename SampleType>
+void AntsDistSatAudioProcessor::updateNoiseSeed(DistortionEngine<SampleType>& activeEngine)
 {
-    // Preserve static variables between calls
-    static float localPhase = 0.0f; // Renamed to avoid hiding class member
-    static float lastSample = 0.0f;
-    static int sampleCount = 0;
-
-    // Downsampling
-    sampleCount++;
-    if (downsample > 1.0f)
-    {
-        if (sampleCount % static_cast<int>(downsample) != 0)
-            return lastSample;
-        lastSample = sample;
-    }
-
-    // Bit depth reduction
-    float maxValue = std::pow(2.0f, bitDepth) - 1.0f;
-    float crushedSample = sample;
-    
-    // Apply bit depth reduction
-    crushedSample = std::floor(crushedSample * maxValue) / maxValue;
-
-    // Apply modulation
-    if (bitModulation > 0.0f)
-    {
-        float modSignal = std::sin(localPhase);
-        crushedSample *= (1.0f + modSignal * bitModulation);
-        localPhase += 0.1f;
-        if (localPhase >= 2.0f * static_cast<float>(M_PI))
-            localPhase -= 2.0f * static_cast<float>(M_PI);
-    }
-
-    // Apply spectral shift
-    if (spectralShift != 0.0f)
-    {
-        crushedSample = spectralShift > 0.0f ? 
-            crushedSample * (1.0f + spectralShift) :
-            crushedSample * (1.0f + spectralShift * 0.5f);
-    }
-
-    // Apply jitter
-    if (jitter > 0.0f)
-    {
-        float jitterAmount = (random.nextFloat() * 2.0f - 1.0f) * jitter;
-        crushedSample += jitterAmount * 0.1f;
-    }
-
-    // Normalize output
-    return std::clamp(crushedSample, -1.0f, 1.0f);
+    // Deterministic jitter uses the project's seed, and picks up a change of
+    // either the switch or a restored seed on the next block. With an offline
+    // render the engine also restarts the noise when the transport starts.
+    const auto noiseSeed = parameterSnapshot->isDeterministicJitter() ? parameterSnapshot->getJitterSeed()
+                                                                      : freeRunningSeed;
+
+    if (noiseSeed != activeEngine.getNoiseSeed())
+        activeEngine.setNoiseSeed(noiseSeed);
 }
 
-
 bool AntsDistSatAudioProcessor::hasEditor() const
 {
     return true;
@@ -390,9 +316,20 @@ void AntsDistSatAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     state.setProperty("mix", mixParam->get(), nullptr);
     state.setProperty("saturation", saturationParam->get(), nullptr);
     state.setProperty("midSide", midSideParam->get(), nullptr);
+    state.setProperty("midSidePairs", midSidePairsParam->getIndex(), nullptr);
     state.setProperty("threshold", thresholdParam->get(), nullptr);
     state.setProperty("attack", attackParam->get(), nullptr);
     state.setProperty("release", releaseParam->get(), nullptr);
+    state.setProperty("oversampling", oversamplingParam->getIndex(), nullptr);
+    state.setProperty("osFilter", oversamplingFilterParam->getIndex(), nullptr);
+    state.setProperty("shaperMode", shaperModeParam->getIndex(), nullptr);
+    state.setProperty("spectralMode", spectralModeParam->getIndex(), nullptr);
+    state.setProperty("bitModRate", bitModulationRateParam->get(), nullptr);
+    state.setProperty("bitModShape", bitModulationShapeParam->getIndex(), nullptr);
+    state.setProperty("bitModSync", bitModulationSyncParam->get(), nullptr);
+    state.setProperty("bitModNote", bitModulationNoteParam->getIndex(), nullptr);
+    state.setProperty("deterministicJitter", deterministicJitterParam->get(), nullptr);
+    state.setProperty("jitterSeed", (int)jitterSeed, nullptr);
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
 }
@@ -409,9 +346,21 @@ void AntsDistSatAudioProcessor::setStateInformation(const void* data, int sizeIn
         *mixParam = state.getProperty("mix", mixParam->get());
         *saturationParam = state.getProperty("saturation", saturationParam->get());
         *midSideParam = state.getProperty("midSide", midSideParam->get());
+        *midSidePairsParam = (int)state.getProperty("midSidePairs", midSidePairsParam->getIndex());
         *thresholdParam = state.getProperty("threshold", thresholdParam->get());
         *attackParam = state.getProperty("attack", attackParam->get());
         *releaseParam = state.getProperty("release", releaseParam->get());
+        *oversamplingParam = (int)state.getProperty("oversampling", oversamplingParam->getIndex());
+        *oversamplingFilterParam = (int)state.getProperty("osFilter", oversamplingFilterParam->getIndex());
+        *shaperModeParam = (int)state.getProperty("shaperMode", shaperModeParam->getIndex());
+        *spectralModeParam = (int)state.getProperty("spectralMode", spectralModeParam->getIndex());
+        *bitModulationRateParam = state.getProperty("bitModRate", bitModulationRateParam->get());
+        *bitModulationShapeParam = (int)state.getProperty("bitModShape", bitModulationShapeParam->getIndex());
+        *bitModulationSyncParam = (bool)state.getProperty("bitModSync", bitModulationSyncParam->get());
+        *bitModulationNoteParam = (int)state.getProperty("bitModNote", bitModulationNoteParam->getIndex());
+        *deterministicJitterParam = (bool)state.getProperty("deterministicJitter", deterministicJitterParam->get());
+        jitterSeed = (juce::uint32)(int)state.getProperty("jitterSeed", (int)jitterSeed);
+        parameterSnapshot->setJitterSeed(jitterSeed);
     }
 }
 
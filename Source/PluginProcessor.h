@@ -1,6 +1,10 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "src/dsp/AnalysisFifo.h"
+#include "src/dsp/DistortionEngine.h"
+#include "src/dsp/ParameterSnapshot.h"
+#include "src/dsp/SpectrumAnalyzer.h"
 
 
 class AntsDistSatAudioProcessor : public juce::AudioProcessor
@@ -15,6 +19,8 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -40,72 +46,91 @@ public:
     juce::AudioParameterFloat* getMixParam() const { return mixParam; }
     juce::AudioParameterFloat* getSaturationParam() const { return saturationParam; }
     juce::AudioParameterFloat* getMidSideParam() const { return midSideParam; }
+    juce::AudioParameterChoice* getMidSidePairsParam() const { return midSidePairsParam; }
     juce::AudioParameterFloat* getThresholdParam() const { return thresholdParam; }
     juce::AudioParameterFloat* getAttackParam() const { return attackParam; }
     juce::AudioParameterFloat* getReleaseParam() const { return releaseParam; }
     juce::AudioParameterFloat* getBitCrushParam() const { return bitCrushParam; }
     juce::AudioParameterFloat* getBitModulationParam() const { return bitModulationParam; }
+    juce::AudioParameterFloat* getBitModulationRateParam() const { return bitModulationRateParam; }
+    juce::AudioParameterChoice* getBitModulationShapeParam() const { return bitModulationShapeParam; }
+    juce::AudioParameterBool* getBitModulationSyncParam() const { return bitModulationSyncParam; }
+    juce::AudioParameterChoice* getBitModulationNoteParam() const { return bitModulationNoteParam; }
     juce::AudioParameterFloat* getSpectralShiftParam() const { return spectralShiftParam; }
     juce::AudioParameterFloat* getDownsampleParam() const { return downsampleParam; }
     juce::AudioParameterFloat* getJitterParam() const { return jitterParam; }
-
-    // Methods for spectrogram
-    const float* getAudioBufferForSpectrogram() const { return spectrogramBuffer.getReadPointer(0); }
-    int getNumSpectrumSamples() const { return spectrogramBuffer.getNumSamples(); }
+    juce::AudioParameterChoice* getOversamplingParam() const { return oversamplingParam; }
+    juce::AudioParameterChoice* getOversamplingFilterParam() const { return oversamplingFilterParam; }
+    juce::AudioParameterChoice* getShaperModeParam() const { return shaperModeParam; }
+    juce::AudioParameterChoice* getSpectralModeParam() const { return spectralModeParam; }
+    juce::AudioParameterBool* getDeterministicJitterParam() const { return deterministicJitterParam; }
+
+    // Spectrum of the first output channel, for the visualiser; the editor
+    // starts and stops its worker thread
+    SpectrumAnalyzer& getSpectrumAnalyzer() { return spectrumAnalyzer; }
     
     // Value tree state for parameter management
     juce::AudioProcessorValueTreeState& getValueTreeState() { return *valueTreeState; }
 
 private:
 
-    static constexpr int fftSize = 1024;
-    static constexpr int fftOrder = 10; // 2^10 = 1024
-    static constexpr int spectrogramBufferSize = 1024; 
+    // Output kept for the visualiser, so it can fall a few frames behind
+    static constexpr double analysisFifoSeconds = 0.5;
 
     juce::AudioParameterFloat* driveParam;
     juce::AudioParameterFloat* mixParam;
     juce::AudioParameterFloat* saturationParam;
     juce::AudioParameterFloat* midSideParam;
+    juce::AudioParameterChoice* midSidePairsParam;
     juce::AudioParameterFloat* thresholdParam;
     juce::AudioParameterFloat* attackParam;
     juce::AudioParameterFloat* releaseParam;
     juce::AudioParameterFloat* bitCrushParam;
     juce::AudioParameterFloat* bitModulationParam;
+    juce::AudioParameterFloat* bitModulationRateParam;
+    juce::AudioParameterChoice* bitModulationShapeParam;
+    juce::AudioParameterBool* bitModulationSyncParam;
+    juce::AudioParameterChoice* bitModulationNoteParam;
     juce::AudioParameterFloat* spectralShiftParam;
     juce::AudioParameterFloat* downsampleParam;
     juce::AudioParameterFloat* jitterParam;
-    juce::AudioBuffer<float> spectrogramBuffer;
+    juce::AudioParameterChoice* oversamplingParam;
+    juce::AudioParameterChoice* oversamplingFilterParam;
+    juce::AudioParameterChoice* shaperModeParam;
+    juce::AudioParameterChoice* spectralModeParam;
+    juce::AudioParameterBool* deterministicJitterParam;
+    AnalysisFifo analysisFifo;
+    SpectrumAnalyzer spectrumAnalyzer { analysisFifo };
     
     // Value tree state for parameter management
     std::unique_ptr<juce::AudioProcessorValueTreeState> valueTreeState;
 
-    float processSample(float sample, float drive, float saturation);
-
-    // Mid-Side processing methods
-    void midSideEncode(juce::AudioBuffer<float>& buffer);
-    void midSideDecode(juce::AudioBuffer<float>& buffer);
-    void processMidSide(juce::AudioBuffer<float>& buffer, float midSideRatio);
-
-    // Noise gate methods and variables
-    float envelopeFollower(float input, float attack, float release);
-    float noiseGate(float input, float threshold, float envelope);
-    float envelope = 0.0f;
-    float attackCoeff = 0.0f;
-    float releaseCoeff = 0.0f;
-
-    // Bitcrushing methods and variables
-    float bitCrush(float sample, float bitDepth, float bitModulation, float spectralShift, float downsample, float jitter);
-    juce::dsp::FFT forwardFFT;
-    juce::dsp::FFT inverseFFT;
-    juce::AudioBuffer<float> fftBuffer;
-    juce::dsp::WindowingFunction<float> window;
-
-    std::vector<float> fftData;
-    std::vector<float> bitCrushBuffer;
-    std::vector<float> modulationBuffer;
-
-    juce::Random random;
-    float phase = 0.0f;
+    // Audio-thread parameter values and derived coefficients, refreshed only on change
+    std::unique_ptr<ParameterSnapshot> parameterSnapshot;
+
+    // Block-based DSP core (gate, shaper, crusher, mix), one per sample type;
+    // only the one matching the host's processing precision is prepared
+    DistortionEngine<float> engine;
+    DistortionEngine<double> doubleEngine;
+
+    // Used for the jitter noise when deterministicJitterParam is on; handed to
+    // the audio thread through the parameter snapshot
+    juce::uint32 jitterSeed = 0;
+
+    // Used otherwise; drawn afresh in every prepareToPlay()
+    juce::uint32 freeRunningSeed = 0;
+
+    // Shared body of both processBlock() overloads
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer, DistortionEngine<SampleType>& activeEngine);
+
+    // Applies the oversampling and spectral modes to the engine and reports any latency change
+    template <typename SampleType>
+    void updateLatency(DistortionEngine<SampleType>& activeEngine);
+
+    // Reseeds the jitter noise when the deterministic switch or the project's seed has changed
+    template <typename SampleType>
+    void updateNoiseSeed(DistortionEngine<SampleType>& activeEngine);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AntsDistSatAudioProcessor)
 };
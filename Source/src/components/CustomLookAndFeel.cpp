@@ -2,6 +2,190 @@
 #include "TextureManager.h"
 #include "../styles/ColorScheme.h"
 
+namespace
+{
+    // Knob geometry shared by the cached layers and the live arc
+    struct KnobGeometry
+    {
+        float radius, centerX, centerY;
+
+        KnobGeometry(float x, float y, float width, float height)
+            : radius(juce::jmin(width, height) * 0.4f),
+              centerX(x + width * 0.5f),
+              centerY(y + height * 0.5f)
+        {
+        }
+    };
+
+    constexpr int numTicks = 48; // More ticks for finer ASCII look
+
+    // Outer ring with glow, the ASCII inner circle and the centre point
+    void drawKnobBack(juce::Graphics& g, int width, int height, juce::Colour knobColor)
+    {
+        const KnobGeometry knob(0.0f, 0.0f, (float)width, (float)height);
+        const float rx = knob.centerX - knob.radius;
+        const float ry = knob.centerY - knob.radius;
+        const float rw = knob.radius * 2.0f;
+
+        // Draw outer ring with glow
+        g.setColour(knobColor.withAlpha(0.15f));
+        g.drawEllipse(rx - 1.0f, ry - 1.0f, rw + 2.0f, rw + 2.0f, 2.0f);
+        g.setColour(knobColor.withAlpha(0.25f));
+        g.drawEllipse(rx, ry, rw, rw, 1.5f);
+
+        // ASCII circle made of characters instead of @ symbol
+        g.setFont(juce::Font("Consolas", juce::jmax(6.0f, knob.radius * 0.12f), juce::Font::plain));
+        const float innerR = knob.radius * 0.25f;
+        const int circlePoints = 16;
+        for (int i = 0; i < circlePoints; ++i)
+        {
+            const float angle = (float)i / (float)circlePoints * juce::MathConstants<float>::twoPi;
+            const float cx = knob.centerX + std::cos(angle) * innerR;
+            const float cy = knob.centerY + std::sin(angle) * innerR;
+            g.setColour(knobColor.withAlpha(0.6f));
+            g.drawFittedText("o", juce::Rectangle<int>((int)cx - 3, (int)cy - 3, 6, 6), juce::Justification::centred, 1);
+        }
+
+        // Center point
+        g.setColour(knobColor);
+        g.drawFittedText("+", juce::Rectangle<int>((int)knob.centerX - 4, (int)knob.centerY - 4, 8, 8), juce::Justification::centred, 1);
+    }
+
+    // Every ASCII tick glyph, all filled or all unfilled
+    void drawKnobTicks(juce::Graphics& g, int width, int height, juce::Colour knobColor,
+                       float rotaryStartAngle, float rotaryEndAngle, bool filled)
+    {
+        const KnobGeometry knob(0.0f, 0.0f, (float)width, (float)height);
+
+        g.setFont(juce::Font("Consolas", juce::jmax(8.0f, knob.radius * 0.16f), juce::Font::plain));
+        g.setColour(filled ? knobColor : knobColor.withAlpha(0.25f));
+        const float tickR = knob.radius * 0.92f;
+        for (int i = 0; i <= numTicks; ++i)
+        {
+            const float t = (float)i / (float)numTicks;
+            const float a = rotaryStartAngle + t * (rotaryEndAngle - rotaryStartAngle);
+            const float tx = knob.centerX + std::cos(a) * tickR;
+            const float ty = knob.centerY + std::sin(a) * tickR;
+
+            // Use different ASCII characters for more variety
+            juce::String tickChar;
+            if (i % 8 == 0)
+            {
+                // Major ticks every 8
+                tickChar = filled ? "+" : ".";
+            }
+            else if (i % 4 == 0)
+            {
+                // Medium ticks every 4
+                tickChar = filled ? ":" : "-";
+            }
+            else
+            {
+                // Minor ticks
+                tickChar = filled ? "|" : ".";
+            }
+
+            g.drawFittedText(tickChar, juce::Rectangle<int>((int)tx - 4, (int)ty - 4, 8, 8), juce::Justification::centred, 1);
+        }
+    }
+
+    // Pie slice over the ticks from t0 to t1 (0..1 of the rotary range),
+    // in the same angle convention the ticks are placed with
+    juce::Path makeTickWedge(const KnobGeometry& knob, float rotaryStartAngle, float rotaryEndAngle, float t0, float t1)
+    {
+        const float a0 = rotaryStartAngle + t0 * (rotaryEndAngle - rotaryStartAngle);
+        const float a1 = rotaryStartAngle + t1 * (rotaryEndAngle - rotaryStartAngle);
+        const float outerR = knob.radius + 12.0f; // Past the tick glyph boxes
+        const int segments = juce::jmax(1, (int)std::ceil(std::abs(a1 - a0) / 0.1f));
+
+        juce::Path wedge;
+        wedge.startNewSubPath(knob.centerX, knob.centerY);
+        for (int i = 0; i <= segments; ++i)
+        {
+            const float a = a0 + (a1 - a0) * (float)i / (float)segments;
+            wedge.lineTo(knob.centerX + std::cos(a) * outerR, knob.centerY + std::sin(a) * outerR);
+        }
+        wedge.closeSubPath();
+        return wedge;
+    }
+
+    // Every ASCII cell of a linear slider, all filled or all unfilled
+    void drawLinearCells(juce::Graphics& g, juce::Slider::SliderStyle style, int width, int height,
+                         juce::Colour sliderColor, bool isFilled)
+    {
+        const juce::String ch = isFilled ? juce::String("#") : juce::String("-");
+
+        if (style == juce::Slider::LinearHorizontal)
+        {
+            // Character grid
+            const int cellW = 10;
+            const int cellH = juce::jmax(12, height - 6);
+            const int top = (height - cellH) / 2;
+            const int cols = juce::jmax(1, width / cellW);
+
+            g.setFont(juce::Font("Consolas", (float)cellH - 2.0f, juce::Font::plain));
+
+            for (int i = 0; i < cols; ++i)
+            {
+                const int px = i * cellW;
+                if (isFilled)
+                {
+                    // Glow effect for filled cells
+                    g.setColour(sliderColor.withAlpha(0.3f));
+                    g.drawText("#", px - 1, top - 1, cellW + 2, cellH + 2, juce::Justification::centred);
+                    g.setColour(sliderColor);
+                }
+                else
+                {
+                    g.setColour(sliderColor.withAlpha(0.15f));
+                }
+                g.drawText(ch, px, top, cellW, cellH, juce::Justification::centred);
+            }
+        }
+        else
+        {
+            // Character grid
+            const int cellH = 12;
+            const int cellW = juce::jmax(12, width - 6);
+            const int rows = juce::jmax(1, height / cellH);
+
+            g.setFont(juce::Font("Consolas", (float)cellH - 1.0f, juce::Font::plain));
+
+            for (int r = 0; r < rows; ++r)
+            {
+                const int py = height - (r + 1) * cellH;
+                if (isFilled)
+                {
+                    g.setColour(sliderColor.withAlpha(0.3f));
+                    g.drawText("#", (width - cellW) / 2 - 1, py - 1, cellW + 2, cellH + 2, juce::Justification::centred);
+                    g.setColour(sliderColor);
+                }
+                else
+                {
+                    g.setColour(sliderColor.withAlpha(0.15f));
+                }
+                g.drawText(ch, (width - cellW) / 2, py, cellW, cellH, juce::Justification::centred);
+            }
+        }
+    }
+
+    // Renders a layer covering width x height plus padding on every side, at
+    // the display's physical resolution
+    template <typename DrawFunction>
+    juce::Image renderLayer(int width, int height, int padding, float scale, DrawFunction&& draw)
+    {
+        juce::Image layer(juce::Image::ARGB,
+                          juce::jmax(1, juce::roundToInt((float)(width + 2 * padding) * scale)),
+                          juce::jmax(1, juce::roundToInt((float)(height + 2 * padding) * scale)),
+                          true);
+
+        juce::Graphics g(layer);
+        g.addTransform(juce::AffineTransform::translation((float)padding, (float)padding).scaled(scale));
+        draw(g);
+        return layer;
+    }
+}
+
 CustomLookAndFeel::CustomLookAndFeel()
 {
     // Set default colors for standard components
@@ -27,85 +211,60 @@ void CustomLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int wi
 {
     // Get color based on parameter name (use neon colors)
     juce::Colour knobColor = ColorScheme::getColorForParameter(slider.getName());
-    
+
+    const LayerKey key { (int)slider.getSliderStyle(), width, height, knobColor.getARGB(),
+                         g.getInternalContext().getPhysicalPixelScaleFactor(), rotaryStartAngle, rotaryEndAngle };
+    const auto& layers = getSliderLayers(key, [&](SliderLayers& newLayers)
+    {
+        newLayers.padding = 2;
+        newLayers.back = renderLayer(width, height, newLayers.padding, key.scale,
+                                     [&](juce::Graphics& lg) { drawKnobBack(lg, width, height, knobColor); });
+        newLayers.unfilled = renderLayer(width, height, newLayers.padding, key.scale,
+                                         [&](juce::Graphics& lg) { drawKnobTicks(lg, width, height, knobColor, rotaryStartAngle, rotaryEndAngle, false); });
+        newLayers.filled = renderLayer(width, height, newLayers.padding, key.scale,
+                                       [&](juce::Graphics& lg) { drawKnobTicks(lg, width, height, knobColor, rotaryStartAngle, rotaryEndAngle, true); });
+    });
+
+    const auto layerArea = juce::Rectangle<int>(x, y, width, height).expanded(layers.padding).toFloat();
+    g.drawImage(layers.back, layerArea);
+
     // Calculate dimensions
-    const float radius = juce::jmin(width, height) * 0.4f;
-    const float centerX = x + width * 0.5f;
-    const float centerY = y + height * 0.5f;
-    const float rx = centerX - radius;
-    const float ry = centerY - radius;
-    const float rw = radius * 2.0f;
-    
-    // Draw outer ring with glow
-    juce::Colour glowColor = knobColor.withAlpha(0.15f);
-    g.setColour(glowColor);
-    g.drawEllipse(rx - 1.0f, ry - 1.0f, rw + 2.0f, rw + 2.0f, 2.0f);
-    g.setColour(knobColor.withAlpha(0.25f));
-    g.drawEllipse(rx, ry, rw, rw, 1.5f);
-    
+    const KnobGeometry knob((float)x, (float)y, (float)width, (float)height);
+    const float rx = knob.centerX - knob.radius;
+    const float ry = knob.centerY - knob.radius;
+    const float rw = knob.radius * 2.0f;
+
     // Calculate angle
     const float angle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
-    
+
     // Draw value arc with neon color and glow
     juce::Path valueArc;
     valueArc.addArc(rx, ry, rw, rw, rotaryStartAngle, angle, true);
     g.setColour(knobColor);
     g.strokePath(valueArc, juce::PathStrokeType(2.5f, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
-    
+
     // Add glow to value arc
     g.setColour(knobColor.withAlpha(0.4f));
     g.strokePath(valueArc, juce::PathStrokeType(4.0f, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
-    
-    // More detailed ASCII tick glyphs for better ASCII aesthetic
-    g.setFont(juce::Font("Consolas", juce::jmax(8.0f, radius * 0.16f), juce::Font::plain));
-    const int numTicks = 48; // More ticks for finer ASCII look
-    const float tickR = radius * 0.92f;
-    for (int i = 0; i <= numTicks; ++i)
-    {
-        const float t = (float)i / (float)numTicks;
-        const float a = rotaryStartAngle + t * (rotaryEndAngle - rotaryStartAngle);
-        const float tx = centerX + std::cos(a) * tickR;
-        const float ty = centerY + std::sin(a) * tickR;
-        const bool filled = (a <= angle);
-        
-        // Use different ASCII characters for more variety
-        juce::String tickChar;
-        if (i % 8 == 0)
-        {
-            // Major ticks every 8
-            tickChar = filled ? "+" : ".";
-        }
-        else if (i % 4 == 0)
-        {
-            // Medium ticks every 4
-            tickChar = filled ? ":" : "-";
-        }
-        else
-        {
-            // Minor ticks
-            tickChar = filled ? "|" : ".";
-        }
-        
-        g.setColour(filled ? knobColor : knobColor.withAlpha(0.25f));
-        g.drawFittedText(tickChar, juce::Rectangle<int>((int)tx - 4, (int)ty - 4, 8, 8), juce::Justification::centred, 1);
+
+    // Ticks up to the value come from the filled layer, the rest from the
+    // unfilled one; the split falls halfway between two ticks
+    const int lastFilledTick = juce::jlimit(0, numTicks, (int)std::floor(sliderPos * (float)numTicks + 1.0e-4f));
+    const float split = ((float)lastFilledTick + 0.5f) / (float)numTicks;
+    const float margin = 0.5f / (float)numTicks;
+
+    {
+        const juce::Graphics::ScopedSaveState state(g);
+        g.reduceClipRegion(makeTickWedge(knob, rotaryStartAngle, rotaryEndAngle, -margin, split));
+        g.drawImage(layers.filled, layerArea);
     }
-    
-    // ASCII circle made of characters instead of @ symbol
-    g.setFont(juce::Font("Consolas", juce::jmax(6.0f, radius * 0.12f), juce::Font::plain));
-    const float innerR = radius * 0.25f;
-    const int circlePoints = 16;
-    for (int i = 0; i < circlePoints; ++i)
-    {
-        const float angle = (float)i / (float)circlePoints * juce::MathConstants<float>::twoPi;
-        const float cx = centerX + std::cos(angle) * innerR;
-        const float cy = centerY + std::sin(angle) * innerR;
-        g.setColour(knobColor.withAlpha(0.6f));
-        g.drawFittedText("o", juce::Rectangle<int>((int)cx - 3, (int)cy - 3, 6, 6), juce::Justification::centred, 1);
+
+    if (lastFilledTick < numTicks)
+    {
+        const juce::Graphics::ScopedSaveState state(g);
+        g.reduceClipRegion(makeTickWedge(knob, rotaryStartAngle, rotaryEndAngle, split, 1.0f + margin));
+        g.drawImage(layers.unfilled, layerArea);
     }
-    
-    // Center point
-    g.setColour(knobColor);
-    g.drawFittedText("+", juce::Rectangle<int>((int)centerX - 4, (int)centerY - 4, 8, 8), juce::Justification::centred, 1);
 }
 
 juce::Font CustomLookAndFeel::getLabelFont(juce::Label& /*label*/)
@@ -121,74 +280,65 @@ void CustomLookAndFeel::drawLinearSlider(juce::Graphics& g, int x, int y, int wi
     // ASCII-style linear sliders with neon colors
     juce::Colour sliderColor = ColorScheme::getColorForParameter(slider.getName());
 
-    if (style == juce::Slider::LinearHorizontal)
+    if (style != juce::Slider::LinearHorizontal && style != juce::Slider::LinearVertical)
     {
-        // Compute normalized position [0..1]
-        const float norm = (maxSliderPos > minSliderPos) ? (sliderPos - minSliderPos) / (maxSliderPos - minSliderPos) : 0.0f;
+        LookAndFeel_V4::drawLinearSlider(g, x, y, width, height, sliderPos, minSliderPos, maxSliderPos, style, slider);
+        return;
+    }
+
+    const LayerKey key { (int)style, width, height, sliderColor.getARGB(),
+                         g.getInternalContext().getPhysicalPixelScaleFactor() };
+    const auto& layers = getSliderLayers(key, [&](SliderLayers& newLayers)
+    {
+        // Cells taller or wider than a thin slider, and their glow, spill past its bounds
+        newLayers.padding = 2 + juce::jmax(0, 14 - juce::jmin(width, height)) / 2;
+        newLayers.unfilled = renderLayer(width, height, newLayers.padding, key.scale,
+                                         [&](juce::Graphics& lg) { drawLinearCells(lg, style, width, height, sliderColor, false); });
+        newLayers.filled = renderLayer(width, height, newLayers.padding, key.scale,
+                                       [&](juce::Graphics& lg) { drawLinearCells(lg, style, width, height, sliderColor, true); });
+    });
+
+    // Compute normalized position [0..1]
+    const float norm = (maxSliderPos > minSliderPos) ? (sliderPos - minSliderPos) / (maxSliderPos - minSliderPos) : 0.0f;
 
-        // Character grid
+    const auto layerArea = juce::Rectangle<int>(x, y, width, height).expanded(layers.padding);
+    juce::Rectangle<int> filledArea, unfilledArea;
+
+    if (style == juce::Slider::LinearHorizontal)
+    {
+        // Cells fill from the left; the boundary keeps the last filled cell's glow
         const int cellW = 10;
-        const int cellH = juce::jmax(12, height - 6);
-        const int left = x;
-        const int top = y + (height - cellH) / 2;
         const int cols = juce::jmax(1, width / cellW);
         const int filled = juce::jlimit(0, cols, (int)std::round(norm * cols));
+        const int boundary = x + filled * cellW + (filled > 0 ? 1 : 0);
 
-        g.setFont(juce::Font("Consolas", (float)cellH - 2.0f, juce::Font::plain));
-
-        for (int i = 0; i < cols; ++i)
-        {
-            const int px = left + i * cellW;
-            const bool isFilled = (i < filled);
-            if (isFilled)
-            {
-                // Glow effect for filled cells
-                g.setColour(sliderColor.withAlpha(0.3f));
-                g.drawText("#", px - 1, top - 1, cellW + 2, cellH + 2, juce::Justification::centred);
-                g.setColour(sliderColor);
-            }
-            else
-            {
-                g.setColour(sliderColor.withAlpha(0.15f));
-            }
-            const juce::String ch = isFilled ? juce::String("#") : juce::String("-");
-            g.drawText(ch, px, top, cellW, cellH, juce::Justification::centred);
-        }
+        filledArea = layerArea.withRight(boundary);
+        unfilledArea = layerArea.withLeft(boundary);
     }
-    else if (style == juce::Slider::LinearVertical)
+    else
     {
-        // Compute normalized position [0..1]
-        const float norm = (maxSliderPos > minSliderPos) ? (sliderPos - minSliderPos) / (maxSliderPos - minSliderPos) : 0.0f;
-
-        // Character grid
+        // Cells fill from the bottom
         const int cellH = 12;
-        const int cellW = juce::jmax(12, width - 6);
         const int rows = juce::jmax(1, height / cellH);
         const int filled = juce::jlimit(0, rows, (int)std::round(norm * rows));
+        const int boundary = y + height - filled * cellH - (filled > 0 ? 1 : 0);
 
-        g.setFont(juce::Font("Consolas", (float)cellH - 1.0f, juce::Font::plain));
+        filledArea = layerArea.withTop(boundary);
+        unfilledArea = layerArea.withBottom(boundary);
+    }
 
-        for (int r = 0; r < rows; ++r)
-        {
-            const int py = y + height - (r + 1) * cellH;
-            const bool isFilled = (r < filled);
-            if (isFilled)
-            {
-                g.setColour(sliderColor.withAlpha(0.3f));
-                g.drawText("#", x + (width - cellW) / 2 - 1, py - 1, cellW + 2, cellH + 2, juce::Justification::centred);
-                g.setColour(sliderColor);
-            }
-            else
-            {
-                g.setColour(sliderColor.withAlpha(0.15f));
-            }
-            const juce::String ch = isFilled ? juce::String("#") : juce::String("-");
-            g.drawText(ch, x + (width - cellW) / 2, py, cellW, cellH, juce::Justification::centred);
-        }
+    if (! filledArea.isEmpty())
+    {
+        const juce::Graphics::ScopedSaveState state(g);
+        g.reduceClipRegion(filledArea);
+        g.drawImage(layers.filled, layerArea.toFloat());
     }
-    else
+
+    if (! unfilledArea.isEmpty())
     {
-        LookAndFeel_V4::drawLinearSlider(g, x, y, width, height, sliderPos, minSliderPos, maxSliderPos, style, slider);
+        const juce::Graphics::ScopedSaveState state(g);
+        g.reduceClipRegion(unfilledArea);
+        g.drawImage(layers.unfilled, layerArea.toFloat());
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <map>
 #include "../styles/ColorScheme.h"
 
 class CustomLookAndFeel : public juce::LookAndFeel_V4
@@ -26,4 +27,53 @@ public:
     
     // CRT glow effect
     void drawCRTGlow(juce::Graphics& g, juce::Rectangle<int> bounds);
+
+private:
+    // The text-drawn parts of the sliders are rendered once per size, colour
+    // and display scale, so a value change only redraws the arc and blits
+    // the cached layers with a clip
+    struct LayerKey
+    {
+        int style = 0;
+        int width = 0;
+        int height = 0;
+        juce::uint32 colour = 0;
+        float scale = 1.0f;
+        float startAngle = 0.0f;
+        float endAngle = 0.0f;
+
+        bool operator<(const LayerKey& other) const
+        {
+            return std::tie(style, width, height, colour, scale, startAngle, endAngle)
+                 < std::tie(other.style, other.width, other.height, other.colour, other.scale, other.startAngle, other.endAngle);
+        }
+    };
+
+    struct SliderLayers
+    {
+        juce::Image back;       // Rings and centre of a rotary; unused for linear sliders
+        juce::Image unfilled;   // Every tick or cell in its unfilled state
+        juce::Image filled;     // Every tick or cell in its filled state
+        int padding = 0;        // Extra pixels around the slider bounds
+    };
+
+    // Entries for sizes no longer on screen are dropped beyond this many
+    static constexpr size_t maxCachedLayers = 32;
+
+    std::map<LayerKey, SliderLayers> sliderLayers;
+
+    // Returns the cached layers for key, calling build to render them on a miss
+    template <typename BuildFunction>
+    const SliderLayers& getSliderLayers(const LayerKey& key, BuildFunction&& build)
+    {
+        if (auto cached = sliderLayers.find(key); cached != sliderLayers.end())
+            return cached->second;
+
+        if (sliderLayers.size() >= maxCachedLayers)
+            sliderLayers.clear();
+
+        auto& layers = sliderLayers[key];
+        build(layers);
+        return layers;
+    }
 }; 
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "GlyphAtlas.h"
+
+GlyphAtlas::GlyphAtlas(const juce::String& glyphsToRender, const juce::Array<juce::Colour>& coloursToRender, float minimumAlpha)
+    : glyphs(glyphsToRender),
+      colours(coloursToRender),
+      minAlpha(juce::jlimit(0.0f, 1.0f, minimumAlpha))
+{
+}
+
+void GlyphAtlas::prepare(int newCellWidth, int newCellHeight, float newScale)
+{
+    if (newCellWidth == cellWidth && newCellHeight == cellHeight && newScale == scale && ! pixels.empty())
+        return;
+
+    cellWidth = newCellWidth;
+    cellHeight = newCellHeight;
+    scale = newScale;
+    render();
+}
+
+int GlyphAtlas::getAlphaLevel(float alpha) const noexcept
+{
+    const float position = (alpha - minAlpha) / juce::jmax(1.0e-3f, 1.0f - minAlpha);
+    return juce::jlimit(0, alphaLevels - 1, juce::roundToInt(position * (float)(alphaLevels - 1)));
+}
+
+void GlyphAtlas::blit(const juce::Image::BitmapData& dest, int glyph, int colour, int alphaLevel,
+                      int x, int y, int clipTop, int clipBottom) const noexcept
+{
+    if (glyph < 0 || pixels.empty())
+        return;
+
+    const int top = juce::jmax(y, clipTop, 0);
+    const int bottom = juce::jmin(y + sourceHeight, clipBottom, dest.height);
+    const int left = juce::jmax(x, 0);
+    const int right = juce::jmin(x + sourceWidth, dest.width);
+
+    const auto* cell = pixels.data() + (size_t)((colour * alphaLevels + alphaLevel) * sourceHeight) * (size_t)atlasWidth
+                                     + (size_t)(glyph * sourceWidth);
+
+    for (int row = top; row < bottom; ++row)
+    {
+        const auto* source = cell + (size_t)(row - y) * (size_t)atlasWidth;
+        auto* target = reinterpret_cast<juce::uint32*>(dest.getLinePointer(row));
+
+        for (int column = left; column < right; ++column)
+        {
+            const juce::uint32 s = source[column - x];
+            const juce::uint32 sourceAlpha = s >> 24;
+
+            if (sourceAlpha == 0)
+                continue;
+
+            // Premultiplied "over", two channels at a time
+            const juce::uint32 d = target[column];
+            const juce::uint32 inverse = 256 - sourceAlpha;
+            const juce::uint32 redBlue = (((d & 0x00ff00ffu) * inverse) >> 8) & 0x00ff00ffu;
+            const juce::uint32 alphaGreen = (((d >> 8) & 0x00ff00ffu) * inverse) & 0xff00ff00u;
+            target[column] = s + (redBlue | alphaGreen);
+        }
+    }
+}
+
+void GlyphAtlas::render()
+{
+    // Each cell gets a whole number of physical pixels, so blits never blur
+    sourceWidth = juce::jmax(1, juce::roundToInt((float)getCellWidth() * scale));
+    sourceHeight = juce::jmax(1, juce::roundToInt((float)getCellHeight() * scale));
+
+    atlasWidth = glyphs.length() * sourceWidth;
+    const int atlasHeight = colours.size() * alphaLevels * sourceHeight;
+
+    // A software image, so this works off the message thread with any renderer
+    juce::Image atlas(juce::Image::ARGB, atlasWidth, atlasHeight, true, juce::SoftwareImageType());
+    const juce::Font font("Consolas", (float)cellHeight - 1.0f, juce::Font::plain);
+    juce::Graphics g(atlas);
+
+    for (int colour = 0; colour < colours.size(); ++colour)
+    {
+        for (int level = 0; level < alphaLevels; ++level)
+        {
+            const float alpha = minAlpha + (1.0f - minAlpha) * (float)level / (float)(alphaLevels - 1);
+            const auto glyphColour = colours[colour].withAlpha(alpha);
+            const int row = colour * alphaLevels + level;
+
+            for (int glyph = 0; glyph < glyphs.length(); ++glyph)
+            {
+                const juce::Graphics::ScopedSaveState state(g);
+                g.setOrigin(glyph * sourceWidth, row * sourceHeight);
+                g.reduceClipRegion(0, 0, sourceWidth, sourceHeight);
+                g.addTransform(juce::AffineTransform::scale(scale));
+                g.setFont(font);
+
+                const auto text = juce::String::charToString(glyphs[glyph]);
+
+                // Glow, then the glyph itself, both centred in the cell
+                g.setColour(glyphColour.withAlpha(alpha * 0.4f));
+                g.drawText(text, 0, 0, getCellWidth(), getCellHeight(), juce::Justification::centred);
+
+                g.setColour(glyphColour);
+                g.drawText(text, 1, 1, cellWidth, cellHeight, juce::Justification::centred);
+            }
+        }
+    }
+
+    pixels.resize((size_t)atlasWidth * (size_t)atlasHeight);
+    const juce::Image::BitmapData source(atlas, juce::Image::BitmapData::readOnly);
+
+    for (int row = 0; row < atlasHeight; ++row)
+        std::memcpy(pixels.data() + (size_t)row * (size_t)atlasWidth, source.getLinePointer(row),
+                    (size_t)atlasWidth * sizeof(juce::uint32));
+}
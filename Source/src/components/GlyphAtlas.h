@@ -0,0 +1,55 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Pre-rendered ASCII glyphs for the character-grid displays.
+//
+// Every glyph is drawn once per colour and alpha level, with its glow
+// underneath, at the display's physical pixel scale. The premultiplied
+// pixels are kept in memory, so drawing a cell is a plain blend into an
+// Image::BitmapData with no text layout and no graphics context; any thread
+// may do it. The atlas is re-rendered only when the cell size or the scale
+// factor changes.
+class GlyphAtlas
+{
+public:
+    // Alpha is quantised to this many steps between minAlpha and 1
+    static constexpr int alphaLevels = 8;
+
+    GlyphAtlas(const juce::String& glyphs, const juce::Array<juce::Colour>& colours, float minAlpha);
+
+    // Re-renders the atlas if the cell size or scale has changed
+    void prepare(int newCellWidth, int newCellHeight, float newScale);
+
+    int getGlyphIndex(juce::juce_wchar character) const { return glyphs.indexOfChar(character); }
+    int getAlphaLevel(float alpha) const noexcept;
+
+    // Blends a glyph cell over dest with its top left at x, y in physical
+    // pixels, touching only rows from clipTop up to clipBottom. The cell is
+    // one logical pixel larger than the grid cell on each side for the glow.
+    void blit(const juce::Image::BitmapData& dest, int glyph, int colour, int alphaLevel,
+              int x, int y, int clipTop, int clipBottom) const noexcept;
+
+    int getCellWidth() const noexcept { return cellWidth + 2; }
+    int getCellHeight() const noexcept { return cellHeight + 2; }
+
+private:
+    void render();
+
+    const juce::String glyphs;
+    const juce::Array<juce::Colour> colours;
+    const float minAlpha;
+
+    int cellWidth = 0;
+    int cellHeight = 0;
+    float scale = 0.0f;
+
+    // Premultiplied ARGB, one cell of sourceWidth x sourceHeight per glyph
+    // across and per colour and alpha level down
+    std::vector<juce::uint32> pixels;
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+    int atlasWidth = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GlyphAtlas)
+};
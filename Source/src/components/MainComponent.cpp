@@ -50,6 +50,7 @@ MainComponent::MainComponent(juce::AudioProcessor& processor, juce::AudioProcess
     addKnob("mix",          "MIX");
     addKnob("bitcrush",     "BIT");
     addKnob("bitmodulation","MOD");
+    addKnob("bitmodrate",   "RATE");
     addKnob("downsample",   "DOWN");
     addKnob("jitter",       "JITTER");
     addKnob("threshold",    "THRESH");
@@ -117,7 +118,7 @@ void MainComponent::resized()
                 driveKnobs.add(k);
             else if (id == "saturation" || id == "midside")
                 distortionKnobs.add(k);
-            else if (id == "bitcrush" || id == "bitmodulation" || id == "downsample" || id == "jitter")
+            else if (id == "bitcrush" || id == "bitmodulation" || id == "bitmodrate" || id == "downsample" || id == "jitter")
                 bitcrushKnobs.add(k);
             else
                 dynamicsKnobs.add(k);
@@ -156,7 +157,7 @@ void MainComponent::resized()
             yPos += knobHeight + gap;
         }
 
-        // Row 3: Bit Crusher (4 knobs)
+        // Row 3: Bit Crusher (5 knobs)
         if (bitcrushKnobs.size() > 0)
         {
             int totalWidth = (bitcrushKnobs.size() * knobWidth) + ((bitcrushKnobs.size() - 1) * gap);
@@ -187,10 +188,7 @@ void MainComponent::resized()
 }
 
 
-void MainComponent::updateVisualizer(const float* buffer, int size)
+bool MainComponent::updateVisualizer(SpectrumAnalyzer& spectrumAnalyzer)
 {
-    if (visualiser != nullptr && buffer != nullptr && size > 0)
-    {
-        visualiser->setAudioBuffer(buffer, size);
-    }
+    return visualiser != nullptr && visualiser->advanceFrame(spectrumAnalyzer);
 }
\ No newline at end of file
@@ -15,8 +15,8 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
     
-    // Update the visualizer with new audio data
-    void updateVisualizer(const float* buffer, int size);
+    // Advance the visualizer by one frame; returns whether new spectrum data arrived
+    bool updateVisualizer(SpectrumAnalyzer& spectrumAnalyzer);
     
 
 private:
@@ -2,9 +2,10 @@
 
 #include <JuceHeader.h>
 #include "../styles/ColorScheme.h"
+#include "../dsp/SpectrumAnalyzer.h"
+#include "VisualiserRenderer.h"
 
-class VisualiserComponent : public juce::Component,
-                           private juce::Timer
+class VisualiserComponent : public juce::Component
 {
 public:
     VisualiserComponent();
@@ -13,8 +14,10 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
     
-    // Set the audio buffer to visualize
-    void setAudioBuffer(const float* buffer, int size);
+    // Called by the editor's frame clock: shows any finished frame and queues
+    // the next one if something has changed. Returns whether new analysis
+    // data arrived; message thread only.
+    bool advanceFrame(SpectrumAnalyzer& spectrumAnalyzer);
     
     // Set the active section color
     void setActiveColor(juce::Colour newColor);
@@ -23,20 +26,33 @@ public:
     void setIntensity(float newIntensity);
 
 private:
-    void timerCallback() override;
-    void updateVisualisation();
+    // Picks up the analyser's newest frame, if any, and returns whether it did
+    bool readSpectrum(SpectrumAnalyzer& spectrumAnalyzer);
+
+    // Returns whether the display is still moving towards its targets
+    bool updateVisualisation(bool newData);
+    void submitFrame();
     
-    juce::AudioBuffer<float> audioBuffer;
+    juce::uint32 lastFrameNumber = 0;
+    bool hasAudio = false;
     juce::Colour activeColor = juce::Colours::white; // Monochrome
     float intensity = 0.85f; // Higher intensity for more pop
     
-    // Visualization data
+    // Visualization data: one entry per analyser band, lowest first
     std::vector<float> visualData;
     std::vector<float> targetData;
-    std::vector<float> waveformPoints;
+    std::vector<float> peakData;
     
+    // Draws the frames off the message thread
+    VisualiserRenderer renderer;
+    float paintScale = 1.0f;
+    juce::uint32 frameCounter = 0;
+    bool frameInFlight = false;     // Submitted and not yet picked up
+    bool needsFrame = true;         // Still settling, or resized or rescaled
+
     // Animation parameters (faster response for vibration effect)
     float smoothingFactor = 0.5f; // Increased for more reactivity
+    static constexpr float settledThreshold = 1.0e-3f; // Far below one row of the grid
     juce::Random random;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VisualiserComponent)
@@ -0,0 +1,216 @@
+#include "VisualiserRenderer.h"
+#include "../styles/ColorScheme.h"
+
+namespace
+{
+    const juce::String asciiRamp = " .':-=+*#%@"; // low -> high density (more gradation)
+    const juce::String antChars = "A<>^v[]{}";     // Random ant-related characters
+
+    // Most stripe workers worth having; a frame is only a few hundred cells
+    constexpr int maxStripeWorkers = 3;
+
+    // Cheap per-frame scatter for the ants, instead of a random number per cell
+    juce::uint32 hashCell(int column, int row, juce::uint32 frame) noexcept
+    {
+        auto h = ((juce::uint32)column * 73856093u) ^ ((juce::uint32)row * 19349663u) ^ (frame * 83492791u);
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        return h ^ (h >> 15);
+    }
+}
+
+VisualiserRenderer::VisualiserRenderer()
+    : juce::Thread("Visualiser Renderer"),
+      glyphAtlas(asciiRamp + antChars,
+                 { ColorScheme::neonCyan, ColorScheme::neonMagenta, ColorScheme::neonYellow },
+                 0.5f)
+{
+    if (stripePool->pool != nullptr)
+        for (int i = 0; i < stripePool->pool->getNumThreads(); ++i)
+            stripeJobs.add(new StripeJob(*this));
+
+    startThread(juce::Thread::Priority::low);
+}
+
+VisualiserRenderer::~VisualiserRenderer()
+{
+    // render() waits for its stripes, so no job is queued once the thread has stopped
+    stopThread(1000);
+}
+
+VisualiserRenderer::StripePool::StripePool()
+{
+    // Leave half the cores, and a render thread, to the host
+    const int numWorkers = juce::jlimit(0, maxStripeWorkers, juce::SystemStats::getNumCpus() / 2 - 1);
+
+    if (numWorkers > 0)
+        pool = std::make_unique<juce::ThreadPool>(numWorkers, 0, juce::Thread::Priority::low);
+}
+
+VisualiserRenderer::StripeJob::StripeJob(const VisualiserRenderer& owner)
+    : juce::ThreadPoolJob("Visualiser Stripe"),
+      renderer(owner)
+{
+}
+
+juce::ThreadPoolJob::JobStatus VisualiserRenderer::StripeJob::runJob()
+{
+    renderer.renderStripe(*request, *pixels, top, bottom);
+    return jobHasFinished;
+}
+
+void VisualiserRenderer::submitRequest()
+{
+    requests.publish();
+    notify();
+}
+
+void VisualiserRenderer::run()
+{
+    while (! threadShouldExit())
+    {
+        if (requests.acquire())
+            render(requests.getReadBuffer());
+        else
+            wait(-1);
+    }
+}
+
+void VisualiserRenderer::render(const Request& request)
+{
+    if (request.width <= 0 || request.height <= 0)
+        return;
+
+    if (request.width != layoutWidth || request.height != layoutHeight)
+        updateLayout(request);
+
+    glyphAtlas.prepare(cellWidth, cellHeight, request.scale);
+
+    // The frame is rendered at the display's physical resolution
+    const int width = juce::jmax(1, juce::roundToInt((float)request.width * request.scale));
+    const int height = juce::jmax(1, juce::roundToInt((float)request.height * request.scale));
+
+    auto& image = frames.getWriteBuffer();
+
+    if (! image.isValid() || image.getWidth() != width || image.getHeight() != height)
+        image = juce::Image(juce::Image::ARGB, width, height, false, juce::SoftwareImageType());
+
+    {
+        const juce::Image::BitmapData pixels(image, juce::Image::BitmapData::writeOnly);
+
+        const int numStripes = stripeJobs.size() + 1;
+        const int stripeHeight = (height + numStripes - 1) / numStripes;
+
+        for (int stripe = 1; stripe < numStripes; ++stripe)
+        {
+            auto* job = stripeJobs.getUnchecked(stripe - 1);
+            job->request = &request;
+            job->pixels = &pixels;
+            job->top = juce::jmin(height, stripe * stripeHeight);
+            job->bottom = juce::jmin(height, job->top + stripeHeight);
+
+            stripePool->pool->addJob(job, false);
+        }
+
+        renderStripe(request, pixels, 0, juce::jmin(height, stripeHeight));
+
+        // Other editors' stripes may be queued ahead of these; ours still
+        // finish within this frame
+        for (auto* job : stripeJobs)
+            stripePool->pool->waitForJobToFinish(job, -1);
+    }
+
+    frames.publish();
+}
+
+void VisualiserRenderer::updateLayout(const Request& request)
+{
+    layoutWidth = request.width;
+    layoutHeight = request.height;
+
+    // Enough columns to fill the entire width, spread edge to edge
+    cols = juce::jmax(1, (int)std::ceil((float)layoutWidth / (float)cellWidth));
+    rows = juce::jmax(1, layoutHeight / cellHeight);
+
+    columnX.resize((size_t)cols);
+    columnBand.resize((size_t)cols);
+
+    for (int cx = 0; cx < cols; ++cx)
+    {
+        const float normalizedPos = (float)cx / (float)juce::jmax(1, cols - 1); // 0.0 to 1.0
+
+        // Mirrored: lowest band at both edges, highest in the centre
+        const float mirroredPos = normalizedPos <= 0.5f ? normalizedPos * 2.0f : (1.0f - normalizedPos) * 2.0f;
+
+        columnX[(size_t)cx] = (int)(normalizedPos * (float)layoutWidth);
+        columnBand[(size_t)cx] = juce::roundToInt(mirroredPos * (float)(SpectrumAnalyzer::numBands - 1));
+    }
+}
+
+void VisualiserRenderer::renderStripe(const Request& request, const juce::Image::BitmapData& pixels, int top, int bottom) const noexcept
+{
+    // Opaque, so already premultiplied
+    const juce::uint32 background = ColorScheme::backgroundDark.getARGB();
+
+    for (int row = top; row < bottom; ++row)
+        std::fill_n(reinterpret_cast<juce::uint32*>(pixels.getLinePointer(row)), pixels.width, background);
+
+    const float scale = request.scale;
+    const float maxAmp = (float)rows * 0.9f; // Max amplitude in rows (90% of height)
+    const int rampLength = asciiRamp.length();
+    const int peakGlyph = glyphAtlas.getGlyphIndex('-');
+    const int brightest = GlyphAtlas::alphaLevels - 1;
+    const int glyphHeight = juce::roundToInt((float)glyphAtlas.getCellHeight() * scale);
+
+    // Vertical spectrum: columns from left to right, amplitude from bottom to top
+    for (int cx = 0; cx < cols; ++cx)
+    {
+        const auto band = (size_t)columnBand[(size_t)cx];
+        const float ampRows = juce::jlimit(0.0f, 1.0f, std::abs(request.levels[band])) * maxAmp;
+        const int peakRow = request.peaks[band] > 0.0f ? (int)(request.peaks[band] * maxAmp) : -1; // Held peak, drawn above the column
+
+        // Cells above both the column and its peak are blank
+        const int litRows = juce::jmin(rows, juce::jmax((int)std::ceil(ampRows), peakRow + 1));
+        const int px = juce::roundToInt((float)(columnX[(size_t)cx] - 1) * scale);
+
+        for (int rowFromBottom = 0; rowFromBottom < litRows; ++rowFromBottom)
+        {
+            const int py = juce::roundToInt((float)((rows - rowFromBottom - 1) * cellHeight - 1) * scale);
+
+            if (py >= bottom || py + glyphHeight <= top)
+                continue;
+
+            const bool withinColumn = (float)rowFromBottom < ampRows;
+
+            if (! withinColumn)
+            {
+                if (rowFromBottom == peakRow)
+                    glyphAtlas.blit(pixels, peakGlyph, yellowGlyph, brightest, px, py, top, bottom);
+
+                continue;
+            }
+
+            // Density based on distance from bottom (peak at top of column)
+            const float proximity = juce::jlimit(0.0f, 1.0f, (float)rowFromBottom / (ampRows + 1e-3f));
+
+            // Cyan at bottom, magenta in middle, yellow at peaks (top of column)
+            const int colour = proximity > 0.7f ? yellowGlyph : (proximity > 0.4f ? magentaGlyph : cyanGlyph);
+
+            // Some "crazy" ant characters scattered through the columns (8% of cells)
+            const auto hash = hashCell(cx, rowFromBottom, request.frameCounter);
+
+            if (hash % 100 < 8)
+            {
+                const int ant = rampLength + (int)((hash / 100) % (juce::uint32)antChars.length());
+                glyphAtlas.blit(pixels, ant, colour, brightest, px, py, top, bottom); // Ants are always bright
+                continue;
+            }
+
+            const int idx = juce::roundToInt(proximity * (float)(rampLength - 1));
+
+            if (idx > 0) // The lowest density is a space
+                glyphAtlas.blit(pixels, idx, colour, glyphAtlas.getAlphaLevel(0.5f + 0.5f * (1.0f - proximity)),
+                                px, py, top, bottom);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "GlyphAtlas.h"
+#include "../dsp/SpectrumAnalyzer.h"
+#include "../dsp/TripleBuffer.h"
+
+// Renders the visualiser's ASCII spectrum grid into an offscreen image on its
+// own thread, so the message thread only ever blits a finished frame.
+//
+// The component fills in a Request (band levels, peaks, size and scale) and
+// submits it; the render thread wakes, writes the frame straight into an
+// Image::BitmapData from the glyph atlas, and publishes it. On machines with
+// cores to spare the frame is split into horizontal stripes rendered in
+// parallel by a small low-priority thread pool, one per process and shared by
+// every open editor, so a session full of plugin windows still only adds a
+// few threads. Requests and frames both travel through
+// TripleBuffers, so neither thread ever waits on the other, and a request
+// that arrives mid-render simply replaces the one queued behind it.
+class VisualiserRenderer : private juce::Thread
+{
+public:
+    static constexpr int cellWidth = 10;    // Cell width for vertical columns
+    static constexpr int cellHeight = 16;   // Character cell height
+
+    struct Request
+    {
+        std::array<float, SpectrumAnalyzer::numBands> levels {};
+        std::array<float, SpectrumAnalyzer::numBands> peaks {};
+        juce::uint32 frameCounter = 0;
+        int width = 0;
+        int height = 0;
+        float scale = 1.0f;
+    };
+
+    VisualiserRenderer();
+    ~VisualiserRenderer() override;
+
+    // Message thread: fill in the request, then submit it
+    Request& getRequestToFill() noexcept { return requests.getWriteBuffer(); }
+    void submitRequest();
+
+    // Message thread: picks up the newest finished frame, if any, and returns
+    // whether it did. The frame stays valid until the next call.
+    bool acquireFrame() noexcept { return frames.acquire(); }
+    const juce::Image& getFrame() const noexcept { return frames.getReadBuffer(); }
+
+private:
+    void run() override;
+    void render(const Request& request);
+    void updateLayout(const Request& request);
+    void renderStripe(const Request& request, const juce::Image::BitmapData& pixels, int top, int bottom) const noexcept;
+
+    // The stripe workers shared by every renderer in the process; no pool on
+    // machines with too few cores to be worth it
+    struct StripePool
+    {
+        StripePool();
+        std::unique_ptr<juce::ThreadPool> pool;
+    };
+
+    // One stripe of the frame being rendered. The renderer owns its jobs and
+    // waits for each one, so none outlives the frame or the renderer.
+    struct StripeJob : public juce::ThreadPoolJob
+    {
+        explicit StripeJob(const VisualiserRenderer& owner);
+        JobStatus runJob() override;
+
+        const VisualiserRenderer& renderer;
+        const Request* request = nullptr;
+        const juce::Image::BitmapData* pixels = nullptr;
+        int top = 0;
+        int bottom = 0;
+    };
+
+    TripleBuffer<Request> requests;
+    TripleBuffer<juce::Image> frames;
+
+    // Glyphs pre-rendered per colour and alpha, in the order passed to the atlas
+    enum GlyphColour { cyanGlyph = 0, magentaGlyph, yellowGlyph };
+    GlyphAtlas glyphAtlas;
+
+    // Grid geometry for the current size, in logical pixels
+    int layoutWidth = -1;
+    int layoutHeight = -1;
+    int cols = 0;
+    int rows = 0;
+    std::vector<int> columnX;
+    std::vector<int> columnBand;
+
+    juce::SharedResourcePointer<StripePool> stripePool;
+    juce::OwnedArray<StripeJob> stripeJobs;     // Stripes after the first, which this thread renders
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VisualiserRenderer)
+};
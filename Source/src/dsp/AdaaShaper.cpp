@@ -0,0 +1,228 @@
+#include "AdaaShaper.h"
+#include "ShaperCurve.h"
+
+namespace
+{
+    constexpr int numTablePoints = (int)AdaaShaper::tableRange * AdaaShaper::pointsPerUnit + 1;
+    constexpr double tableStep = 1.0 / (double)AdaaShaper::pointsPerUnit;
+
+    // Central difference step for the slope table
+    constexpr double slopeStep = 1.0e-5;
+
+    // Below these input differences the divided differences lose precision
+    constexpr double firstOrderTolerance = 1.0e-5;
+    constexpr double secondOrderTolerance = 1.0e-4;
+}
+
+AdaaShaper::Tables::Tables()
+{
+    const auto size = (size_t)(numSaturationSlices * numTablePoints);
+    slope.resize(size);
+    curve.resize(size);
+    first.resize(size);
+    second.resize(size);
+
+    for (int slice = 0; slice < numSaturationSlices; ++slice)
+    {
+        const ShaperCurve<double> shaper((double)slice / (double)(numSaturationSlices - 1));
+        const auto offset = (size_t)(slice * numTablePoints);
+        auto* df = slope.data() + offset;
+        auto* f = curve.data() + offset;
+        auto* F1 = first.data() + offset;
+        auto* F2 = second.data() + offset;
+
+        for (int i = 0; i < numTablePoints; ++i)
+        {
+            const double x = i * tableStep;
+
+            f[i] = shaper(x);
+            df[i] = (shaper(x + slopeStep) - shaper(x - slopeStep)) / (2.0 * slopeStep);
+        }
+
+        // F1 by Simpson's rule per cell, F2 by integrating the Hermite cubic
+        // of F1 exactly, both from zero at the origin
+        F1[0] = 0.0;
+        F2[0] = 0.0;
+
+        for (int i = 0; i < numTablePoints - 1; ++i)
+        {
+            const double fMid = shaper((i + 0.5) * tableStep);
+
+            F1[i + 1] = F1[i] + tableStep / 6.0 * (f[i] + 4.0 * fMid + f[i + 1]);
+            F2[i + 1] = F2[i] + tableStep * 0.5 * (F1[i] + F1[i + 1]) + tableStep * tableStep / 12.0 * (f[i] - f[i + 1]);
+        }
+    }
+}
+
+void AdaaShaper::selectSlices(float saturation) noexcept
+{
+    const double slicePosition = (double)juce::jlimit(0.0f, 1.0f, saturation) * (double)(numSaturationSlices - 1);
+    const int lowerSlice = juce::jmin((int)slicePosition, numSaturationSlices - 2);
+
+    sliceOffset = (size_t)(lowerSlice * numTablePoints);
+    sliceWeight = slicePosition - (double)lowerSlice;
+    lowerSaturation = (double)lowerSlice / (double)(numSaturationSlices - 1);
+    upperSaturation = (double)(lowerSlice + 1) / (double)(numSaturationSlices - 1);
+}
+
+double AdaaShaper::interpolate(const std::vector<double>& values, const std::vector<double>& derivatives,
+                               double magnitude) const noexcept
+{
+    const double position = magnitude * (double)pointsPerUnit;
+    const int index = juce::jlimit(0, numTablePoints - 2, (int)position);
+    const double t = position - (double)index;
+
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+
+    const double h00 = 2.0 * t3 - 3.0 * t2 + 1.0;
+    const double h10 = t3 - 2.0 * t2 + t;
+    const double h01 = -2.0 * t3 + 3.0 * t2;
+    const double h11 = t3 - t2;
+
+    const double* v = values.data() + sliceOffset;
+    const double* d = derivatives.data() + sliceOffset;
+
+    auto blend = [this](const double* lower, int i) { return lower[i] + sliceWeight * (lower[i + numTablePoints] - lower[i]); };
+
+    return h00 * blend(v, index) + h10 * tableStep * blend(d, index)
+         + h01 * blend(v, index + 1) + h11 * tableStep * blend(d, index + 1);
+}
+
+double AdaaShaper::curve(double x) const noexcept
+{
+    // Odd
+    const double magnitude = std::abs(x);
+    double value;
+
+    if (magnitude < tableRange)
+    {
+        value = interpolate(tables->curve, tables->slope, magnitude);
+    }
+    else
+    {
+        const double lower = ShaperCurve<double>(lowerSaturation)(magnitude);
+        value = lower + sliceWeight * (ShaperCurve<double>(upperSaturation)(magnitude) - lower);
+    }
+
+    return x < 0.0 ? -value : value;
+}
+
+double AdaaShaper::firstAntiderivative(double x) const noexcept
+{
+    // Even
+    return interpolate(tables->first, tables->curve, std::abs(x));
+}
+
+double AdaaShaper::secondAntiderivative(double x) const noexcept
+{
+    // Odd
+    const double value = interpolate(tables->second, tables->first, std::abs(x));
+    return x < 0.0 ? -value : value;
+}
+
+template <typename SampleType>
+void AdaaShaper::process(SampleType* data, int numSamples, int order, float saturation, double& history1, double& history2)
+{
+    selectSlices(saturation);
+
+    if (order >= 2)
+    {
+        processSecondOrder(data, numSamples, history1, history2);
+    }
+    else
+    {
+        processFirstOrder(data, numSamples, history1);
+        history2 = history1;
+    }
+}
+
+template <typename SampleType>
+void AdaaShaper::processFirstOrder(SampleType* data, int numSamples, double& history1)
+{
+    double x1 = history1;
+    double F1x1 = firstAntiderivative(x1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double x0 = (double)data[i];
+
+        if (std::abs(x0) >= tableRange || std::abs(x1) >= tableRange)
+        {
+            // Outside the tables: plain (aliasing) evaluation
+            data[i] = (SampleType)curve(x0);
+            F1x1 = firstAntiderivative(x0);
+        }
+        else
+        {
+            const double F1x0 = firstAntiderivative(x0);
+            const double delta = x0 - x1;
+
+            data[i] = std::abs(delta) < firstOrderTolerance ? (SampleType)curve(0.5 * (x0 + x1))
+                                                           : (SampleType)((F1x0 - F1x1) / delta);
+            F1x1 = F1x0;
+        }
+
+        x1 = x0;
+    }
+
+    history1 = x1;
+}
+
+template <typename SampleType>
+void AdaaShaper::processSecondOrder(SampleType* data, int numSamples, double& history1, double& history2)
+{
+    double x1 = history1;
+    double x2 = history2;
+
+    // First divided difference of F2, falling back to F1 at the midpoint
+    auto dividedDifference = [this](double a, double b)
+    {
+        const double delta = a - b;
+
+        if (std::abs(delta) < secondOrderTolerance)
+            return firstAntiderivative(0.5 * (a + b));
+
+        return (secondAntiderivative(a) - secondAntiderivative(b)) / delta;
+    };
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double x0 = (double)data[i];
+
+        if (std::abs(x0) >= tableRange || std::abs(x1) >= tableRange || std::abs(x2) >= tableRange)
+        {
+            data[i] = (SampleType)curve(x0);
+        }
+        else
+        {
+            const double outerDelta = x0 - x2;
+
+            if (std::abs(outerDelta) < secondOrderTolerance)
+            {
+                // x[n] ~ x[n-2]: expand around their mean
+                const double mean = 0.5 * (x0 + x2);
+                const double innerDelta = mean - x1;
+
+                if (std::abs(innerDelta) < secondOrderTolerance)
+                    data[i] = (SampleType)curve(0.5 * (mean + x1));
+                else
+                    data[i] = (SampleType)(2.0 / innerDelta * (firstAntiderivative(mean)
+                                                          + (secondAntiderivative(x1) - secondAntiderivative(mean)) / innerDelta));
+            }
+            else
+            {
+                data[i] = (SampleType)(2.0 / outerDelta * (dividedDifference(x0, x1) - dividedDifference(x1, x2)));
+            }
+        }
+
+        x2 = x1;
+        x1 = x0;
+    }
+
+    history1 = x1;
+    history2 = x2;
+}
+
+template void AdaaShaper::process<float>(float*, int, int, float, double&, double&);
+template void AdaaShaper::process<double>(double*, int, int, float, double&, double&);
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Antiderivative anti-aliasing (ADAA) for the saturation curve.
+//
+// The curve has no closed-form antiderivative (tanh and sines feed a rational
+// clipper), so the first and second antiderivatives are tabulated in double
+// precision over the driven input range and read back with cubic Hermite
+// interpolation, using the curve itself (and F1) as the exact derivatives.
+// Inputs outside the tables fall back to the plain curve, and so do input
+// differences too small to divide by.
+//
+// The tables hold one slice per saturation step and are built once, when the
+// first AdaaShaper in the process is created, and shared through a
+// juce::SharedResourcePointer like ShaperTable. Each block blends the two
+// slices either side of its saturation, so automation never rebuilds anything
+// on the audio thread. A blend of two slices is the exact antiderivative of
+// the same blend of their curves, so the ADAA differences stay consistent,
+// and the plain-curve fallbacks read the same blend so switching between
+// them never steps. The curve is odd, so F1 is even and F2 odd, and only the
+// positive half is stored: about 1 MB for the whole process.
+//
+// First order adds half a sample of group delay to the shaped path and second
+// order adds one sample. Neither changes the reported latency, and the clean
+// and crushed paths are not delayed to match, so at intermediate mix values
+// the paths sum with that offset: at a 50% mix, linear signal content falls
+// by up to 3 dB at Nyquist for first order, and second order has a one-zero
+// lowpass response, 3 dB down at a quarter of the sample rate with a null at
+// Nyquist. At 0% and 100% mix there is no such filtering.
+class AdaaShaper
+{
+public:
+    AdaaShaper() = default;
+
+    // data holds driven samples on entry and shaped samples on exit. history1
+    // and history2 are the channel's x[n-1] and x[n-2], owned by the caller.
+    // The tables are double either way; float and double data are supported.
+    template <typename SampleType>
+    void process(SampleType* data, int numSamples, int order, float saturation, double& history1, double& history2);
+
+    static constexpr double tableRange = 32.0;          // |driven| covered by the tables
+    static constexpr int pointsPerUnit = 32;            // 16 points per period of the highest harmonic
+    static constexpr int numSaturationSlices = 33;
+
+private:
+    // f', f, F1 and F2 over 0 <= driven <= tableRange, slice after slice
+    struct Tables
+    {
+        Tables();
+
+        std::vector<double> slope;      // f'
+        std::vector<double> curve;      // f, f' = slope
+        std::vector<double> first;      // F1, F1' = f
+        std::vector<double> second;     // F2, F2' = F1
+    };
+
+    // Picks the two slices either side of saturation and the weight between them
+    void selectSlices(float saturation) noexcept;
+
+    // The curve blended between the selected slices, for the fallbacks
+    double curve(double x) const noexcept;
+    double firstAntiderivative(double x) const noexcept;
+    double secondAntiderivative(double x) const noexcept;
+
+    // Hermite interpolation at |x| of a table whose derivative is held in
+    // another table, blended between the selected slices
+    double interpolate(const std::vector<double>& values, const std::vector<double>& derivatives, double magnitude) const noexcept;
+
+    template <typename SampleType>
+    void processFirstOrder(SampleType* data, int numSamples, double& history1);
+
+    template <typename SampleType>
+    void processSecondOrder(SampleType* data, int numSamples, double& history1, double& history2);
+
+    juce::SharedResourcePointer<Tables> tables;
+
+    size_t sliceOffset = 0;         // Start of the lower slice in each table
+    double sliceWeight = 0.0;       // Towards the upper slice
+    double lowerSaturation = 0.0;   // Saturation of each slice, for inputs beyond the tables
+    double upperSaturation = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AdaaShaper)
+};
@@ -0,0 +1,68 @@
+#include "AnalysisFifo.h"
+
+void AnalysisFifo::prepare(int capacity)
+{
+    const juce::SpinLock::ScopedLockType lock(resizeLock);
+
+    // AbstractFifo keeps one slot free to tell full from empty
+    const int totalSize = juce::jmax(2, capacity + 1);
+    storage.assign((size_t)totalSize, 0.0f);
+    fifo.setTotalSize(totalSize);
+}
+
+template <typename SampleType>
+void AnalysisFifo::push(const SampleType* samples, int numSamples) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+        return;
+
+    auto* data = storage.data();
+
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        std::memcpy(data + start1, samples, (size_t)size1 * sizeof(float));
+        std::memcpy(data + start2, samples + size1, (size_t)size2 * sizeof(float));
+    }
+    else
+    {
+        for (int i = 0; i < size1; ++i)
+            data[start1 + i] = (float)samples[i];
+
+        for (int i = 0; i < size2; ++i)
+            data[start2 + i] = (float)samples[size1 + i];
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+int AnalysisFifo::readLatest(float* window, int windowSize) noexcept
+{
+    const juce::SpinLock::ScopedLockType lock(resizeLock);
+
+    const int numReady = fifo.getNumReady();
+
+    if (numReady == 0 || windowSize <= 0)
+        return 0;
+
+    // Samples older than the window would be overwritten anyway
+    const int numToRead = juce::jmin(numReady, windowSize);
+    fifo.finishedRead(numReady - numToRead);
+
+    std::memmove(window, window + numToRead, (size_t)(windowSize - numToRead) * sizeof(float));
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numToRead, start1, size1, start2, size2);
+
+    auto* destination = window + windowSize - numToRead;
+    std::memcpy(destination, storage.data() + start1, (size_t)size1 * sizeof(float));
+    std::memcpy(destination + size1, storage.data() + start2, (size_t)size2 * sizeof(float));
+
+    fifo.finishedRead(size1 + size2);
+    return numReady;
+}
+
+template void AnalysisFifo::push<float>(const float*, int) noexcept;
+template void AnalysisFifo::push<double>(const double*, int) noexcept;
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Lock-free ring of output samples from the audio thread to the analysis and
+// display code.
+//
+// One writer (the audio thread) and one reader, coordinated by a
+// juce::AbstractFifo: push() never waits and never allocates, and costs one
+// copy of the block (two when it wraps). If the reader falls behind, the
+// samples that do not fit are dropped rather than overwriting unread ones, so
+// the reader always sees contiguous runs of audio.
+//
+// The storage is sized in prepare(), on the host's thread while the audio
+// thread is stopped. A spin lock keeps the reader off the storage while it is
+// replaced; the audio thread never takes it.
+class AnalysisFifo
+{
+public:
+    AnalysisFifo() = default;
+
+    void prepare(int capacity);
+
+    // Audio thread
+    template <typename SampleType>
+    void push(const SampleType* samples, int numSamples) noexcept;
+
+    // Reader: slides the newest samples into the end of window, keeping its
+    // older contents in order, and returns how many samples arrived. Anything
+    // older than windowSize is skipped.
+    int readLatest(float* window, int windowSize) noexcept;
+
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+
+private:
+    juce::AbstractFifo fifo { 1 };
+    std::vector<float> storage;
+    juce::SpinLock resizeLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisFifo)
+};
@@ -0,0 +1,70 @@
+#include "ChannelStateBlock.h"
+
+template <typename SampleType>
+size_t ChannelStateBlock<SampleType>::getFieldSize(size_t elementSize, int lanes) noexcept
+{
+    const size_t bytes = elementSize * (size_t)lanes;
+    return (bytes + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+}
+
+template <typename SampleType>
+template <typename FieldType>
+FieldType* ChannelStateBlock<SampleType>::allocateField(char* base, size_t& offset) const noexcept
+{
+    auto* field = reinterpret_cast<FieldType*>(base + offset);
+    offset += getFieldSize(sizeof(FieldType), numLanes);
+    return field;
+}
+
+template <typename SampleType>
+void ChannelStateBlock<SampleType>::prepare(int numChannels)
+{
+    numLanes = (juce::jmax(1, numChannels) + laneMultiple - 1) / laneMultiple * laneMultiple;
+
+    // Every field is rounded up to whole cache lines, so each one starts on a line
+    storageSize = 2 * getFieldSize(sizeof(SampleType), numLanes)
+                + getFieldSize(sizeof(juce::int64), numLanes)
+                + 2 * getFieldSize(sizeof(double), numLanes);
+
+    // One spare line to align the start of the block
+    storage.calloc(storageSize + cacheLineSize);
+
+    auto address = reinterpret_cast<juce::pointer_sized_uint>(storage.get());
+    auto* base = reinterpret_cast<char*>((address + cacheLineSize - 1) & ~(juce::pointer_sized_uint)(cacheLineSize - 1));
+
+    size_t offset = 0;
+    envelope = allocateField<SampleType>(base, offset);
+    heldSample = allocateField<SampleType>(base, offset);
+    sampleCount = allocateField<juce::int64>(base, offset);
+    adaaHistory1 = allocateField<double>(base, offset);
+    adaaHistory2 = allocateField<double>(base, offset);
+
+    jassert(offset <= storageSize);
+}
+
+template <typename SampleType>
+void ChannelStateBlock<SampleType>::reset() noexcept
+{
+    if (numLanes == 0)
+        return;
+
+    std::fill(envelope, envelope + numLanes, SampleType(0));
+    std::fill(heldSample, heldSample + numLanes, SampleType(0));
+    std::fill(sampleCount, sampleCount + numLanes, (juce::int64)0);
+    std::fill(adaaHistory1, adaaHistory1 + numLanes, 0.0);
+    std::fill(adaaHistory2, adaaHistory2 + numLanes, 0.0);
+}
+
+template <typename SampleType>
+void ChannelStateBlock<SampleType>::clearSignalState() noexcept
+{
+    if (numLanes == 0)
+        return;
+
+    std::fill(heldSample, heldSample + numLanes, SampleType(0));
+    std::fill(adaaHistory1, adaaHistory1 + numLanes, 0.0);
+    std::fill(adaaHistory2, adaaHistory2 + numLanes, 0.0);
+}
+
+template class ChannelStateBlock<float>;
+template class ChannelStateBlock<double>;
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Per-instance, per-channel DSP state in structure-of-arrays form.
+//
+// Every field is its own array with one lane per channel, so a stage can walk
+// all channels of one field with a single SIMD register. Each array starts on
+// a cache line and is padded to a whole number of lines, and the block as a
+// whole is cache-line aligned, so no two channels' fields written in the same
+// stage and no two plugin instances ever share a line. Sized in prepare(); the
+// audio thread only reads and writes lanes. Sample-valued fields use the
+// engine's sample type.
+template <typename SampleType>
+class ChannelStateBlock
+{
+public:
+    static constexpr int cacheLineSize = 64;
+    static constexpr int laneMultiple = 8;     // Lanes are padded to a whole AVX register of floats
+
+    ChannelStateBlock() = default;
+
+    void prepare(int numChannels);
+    void reset() noexcept;
+
+    // Clears the held samples and ADAA history, keeping the gate envelopes
+    // and the downsample counters
+    void clearSignalState() noexcept;
+
+    int getNumLanes() const noexcept { return numLanes; }
+
+    // Noise gate
+    SampleType* envelope = nullptr;
+
+    // Bitcrusher. The count is 64-bit so it never wraps in a session; a
+    // 32-bit count would overflow after about 12 hours at 48 kHz.
+    SampleType* heldSample = nullptr;
+    juce::int64* sampleCount = nullptr;
+
+    // ADAA input history, x[n-1] and x[n-2]
+    double* adaaHistory1 = nullptr;
+    double* adaaHistory2 = nullptr;
+
+private:
+    template <typename FieldType>
+    FieldType* allocateField(char* base, size_t& offset) const noexcept;
+
+    static size_t getFieldSize(size_t elementSize, int lanes) noexcept;
+
+    juce::HeapBlock<char> storage;
+    size_t storageSize = 0;
+    int numLanes = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelStateBlock)
+};
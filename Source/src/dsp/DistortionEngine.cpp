@@ -0,0 +1,893 @@
+#include "DistortionEngine.h"
+#include "ShaperCurve.h"
+
+std::vector<DistortionEngineBase::ChannelPair> DistortionEngineBase::findMidSidePairs(const juce::AudioChannelSet& layout,
+                                                                                      MidSidePairs mode)
+{
+    std::vector<ChannelPair> pairs;
+
+    if (mode == MidSidePairs::off || layout.getAmbisonicOrder() >= 0)
+        return pairs;
+
+    if (layout.isDiscreteLayout())
+    {
+        const int numPairs = mode == MidSidePairs::front ? juce::jmin(1, layout.size() / 2) : layout.size() / 2;
+
+        for (int pair = 0; pair < numPairs; ++pair)
+            pairs.push_back({ 2 * pair, 2 * pair + 1 });
+
+        return pairs;
+    }
+
+    using Type = juce::AudioChannelSet::ChannelType;
+
+    // Front first, so MidSidePairs::front is the first entry found
+    static constexpr std::pair<Type, Type> speakerPairs[] = {
+        { juce::AudioChannelSet::left, juce::AudioChannelSet::right },
+        { juce::AudioChannelSet::leftCentre, juce::AudioChannelSet::rightCentre },
+        { juce::AudioChannelSet::wideLeft, juce::AudioChannelSet::wideRight },
+        { juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::rightSurround },
+        { juce::AudioChannelSet::leftSurroundSide, juce::AudioChannelSet::rightSurroundSide },
+        { juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::rightSurroundRear },
+        { juce::AudioChannelSet::topFrontLeft, juce::AudioChannelSet::topFrontRight },
+        { juce::AudioChannelSet::topSideLeft, juce::AudioChannelSet::topSideRight },
+        { juce::AudioChannelSet::topRearLeft, juce::AudioChannelSet::topRearRight },
+        { juce::AudioChannelSet::bottomFrontLeft, juce::AudioChannelSet::bottomFrontRight },
+        { juce::AudioChannelSet::bottomSideLeft, juce::AudioChannelSet::bottomSideRight },
+        { juce::AudioChannelSet::bottomRearLeft, juce::AudioChannelSet::bottomRearRight }
+    };
+
+    for (const auto& speakerPair : speakerPairs)
+    {
+        const int left = layout.getChannelIndexForType(speakerPair.first);
+        const int right = layout.getChannelIndexForType(speakerPair.second);
+
+        if (left >= 0 && right >= 0)
+        {
+            pairs.push_back({ left, right });
+
+            if (mode == MidSidePairs::front)
+                break;
+        }
+    }
+
+    return pairs;
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::prepare(double sampleRate, const juce::AudioChannelSet& layout)
+{
+    currentSampleRate = sampleRate;
+    const int channels = juce::jlimit(1, maxChannels, layout.size());
+    preparedChannels = channels;
+    kernels = offlineRendering ? &VectorKernels::get<SampleType>(VectorKernels::InstructionSet::reference)
+                               : &VectorKernels::get<SampleType>();
+
+    for (int mode = 0; mode < (int)midSidePairs.size(); ++mode)
+        midSidePairs[(size_t)mode] = findMidSidePairs(layout, static_cast<MidSidePairs>(mode));
+
+    distortedBuffer.setSize(channels, chunkSize, false, true, false);
+    crushedBuffer.setSize(channels, chunkSize, false, true, false);
+    noiseBuffer.setSize(channels, chunkSize, false, true, false);
+
+    holdMask.assign((size_t)chunkSize, SampleType(0));
+    holdValues.assign((size_t)chunkSize, SampleType(0));
+
+    channelState.prepare(channels);
+    noise.prepare(channels);
+    modulator.prepare(sampleRate, chunkSize);
+    spectralShifter.prepare(channels);
+    frequencyShifter.prepare(chunkSize, channels);
+
+    driveRamp.prepare(sampleRate, rampTimeSeconds, chunkSize);
+    mixRamp.prepare(sampleRate, rampTimeSeconds, chunkSize);
+    midSideRamp.prepare(sampleRate, rampTimeSeconds, chunkSize);
+    crusherLevelsRamp.prepare(sampleRate, rampTimeSeconds, chunkSize, true);
+
+    // Build every oversampler up front; integer latency keeps the dry path
+    // compensation a plain sample delay
+    int maxLatency = 0;
+
+    for (int type = 0; type < 2; ++type)
+    {
+        const bool linearPhase = type == 1;
+        const auto filterType = linearPhase ? juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple
+                                            : juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR;
+
+        for (int order = 1; order <= maxOversamplingOrder; ++order)
+        {
+            auto oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>((size_t)channels, (size_t)order,
+                                                                                    filterType, true, true);
+            oversampler->initProcessing((size_t)chunkSize);
+            maxLatency = juce::jmax(maxLatency, (int)std::round(oversampler->getLatencyInSamples()));
+            oversamplers[(size_t)getOversamplerIndex(order, linearPhase)] = std::move(oversampler);
+        }
+    }
+
+    const juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32)chunkSize, (juce::uint32)channels };
+
+    cleanDelay.setMaximumDelayInSamples(SpectralShifter::getLatencyInSamples());
+    cleanDelay.prepare(spec);
+    dryDelay.setMaximumDelayInSamples(juce::jmax(1, maxLatency));
+    dryDelay.prepare(spec);
+    wetDelay.setMaximumDelayInSamples(SpectralShifter::getLatencyInSamples());
+    wetDelay.prepare(spec);
+
+    // Re-select the current factor against the new objects
+    activeOversampler = nullptr;
+    setOversampling(requestedOversamplingOrder, oversamplingLinearPhase);
+    updateLatency();
+
+    reset();
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::setOversampling(int order, bool linearPhase)
+{
+    requestedOversamplingOrder = juce::jlimit(0, maxOversamplingOrder, order);
+    oversamplingLinearPhase = linearPhase;
+    order = offlineRendering ? maxOversamplingOrder : requestedOversamplingOrder;
+
+    auto* oversampler = order > 0 ? oversamplers[(size_t)getOversamplerIndex(order, linearPhase)].get() : nullptr;
+
+    if (oversampler == activeOversampler && order == oversamplingOrder)
+        return;
+
+    oversamplingOrder = order;
+    activeOversampler = oversampler;
+
+    if (activeOversampler != nullptr)
+        activeOversampler->reset();
+
+    oversamplingLatency = activeOversampler != nullptr ? (int)std::round(activeOversampler->getLatencyInSamples()) : 0;
+    updateLatency();
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::setOfflineRendering(bool shouldRenderOffline)
+{
+    if (shouldRenderOffline == offlineRendering)
+        return;
+
+    offlineRendering = shouldRenderOffline;
+
+    if (kernels != nullptr)
+        kernels = offlineRendering ? &VectorKernels::get<SampleType>(VectorKernels::InstructionSet::reference)
+                                   : &VectorKernels::get<SampleType>();
+
+    // The state of one factor means nothing to another, so start clean
+    if (preparedChannels > 0)
+        reset();
+
+    setOversampling(requestedOversamplingOrder, oversamplingLinearPhase);
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::setTransport(double bpm, double ppqPosition, bool isPlaying) noexcept
+{
+    if (isPlaying && ! transportPlaying && offlineRendering && preparedChannels > 0)
+        reset();
+
+    transportBpm = bpm > 0.0 ? bpm : 120.0;
+    transportBeats = ppqPosition;
+    transportPlaying = isPlaying;
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::setSpectralMode(SpectralMode mode)
+{
+    if (mode == spectralMode)
+        return;
+
+    spectralMode = mode;
+    spectralShifter.reset();
+    frequencyShifter.reset();
+    updateLatency();
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::updateLatency()
+{
+    const int spectralLatency = spectralMode == SpectralMode::stft ? SpectralShifter::getLatencyInSamples() : 0;
+
+    latencySamples = juce::jmax(oversamplingLatency, spectralLatency);
+    cleanDelaySamples = spectralLatency;
+    dryDelaySamples = latencySamples - spectralLatency;
+    wetDelaySamples = latencySamples - oversamplingLatency;
+
+    cleanDelay.reset();
+    cleanDelay.setDelay((SampleType)cleanDelaySamples);
+    dryDelay.reset();
+    dryDelay.setDelay((SampleType)dryDelaySamples);
+    wetDelay.reset();
+    wetDelay.setDelay((SampleType)wetDelaySamples);
+
+    baseTailSamples = latencySamples + (activeOversampler != nullptr ? oversamplingTailSamples : 0);
+    updateTail();
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::updateTail() noexcept
+{
+    // Latency plus the ringing of the filters in use; the frequency shifter
+    // only rings while it is shifting. Read by the host from other threads
+    const bool shifting = spectralMode == SpectralMode::frequencyShifter && frequencyShifter.isActive();
+
+    tailSamples.store(baseTailSamples + (shifting ? FrequencyShifter<SampleType>::tailLengthSamples : 0),
+                      std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::reset()
+{
+    channelState.reset();
+
+    driveRamp.reset();
+    mixRamp.reset();
+    midSideRamp.reset();
+    crusherLevelsRamp.reset();
+
+    distortedBuffer.clear();
+    crushedBuffer.clear();
+
+    for (auto& oversampler : oversamplers)
+        if (oversampler != nullptr)
+            oversampler->reset();
+
+    spectralShifter.reset();
+    frequencyShifter.reset();
+    noise.reset();
+    modulator.reset();
+    cleanDelay.reset();
+    closedGateSamples = 0;
+    outputSilent = false;
+    skippingSilence = false;
+    dryDelay.reset();
+    wetDelay.reset();
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::process(juce::AudioBuffer<SampleType>& buffer, int numChannels, const Parameters& params)
+{
+    numChannels = juce::jmin(numChannels, buffer.getNumChannels(), preparedChannels);
+
+    if (numChannels <= 0)
+        return;
+
+    // Host blocks are split in place into chunkSize chunks plus one shorter
+    // tail, so the stages never see more than chunkSize samples and ramps,
+    // modulation and coefficients only move on chunk boundaries, without
+    // buffering anything or adding latency
+    const int numSamples = buffer.getNumSamples();
+
+    for (int startSample = 0; startSample < numSamples; startSample += chunkSize)
+        processChunk(buffer, startSample, juce::jmin(chunkSize, numSamples - startSample), numChannels, params);
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processChunk(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                                    int numChannels, const Parameters& params)
+{
+    Ramps ramps;
+    ramps.drive = driveRamp.getNextBlock(params.drive, numSamples);
+    ramps.mix = mixRamp.getNextBlock(params.mix, numSamples);
+    ramps.midSide = midSideRamp.getNextBlock(params.midSide, numSamples);
+    ramps.crusherLevels = crusherLevelsRamp.getNextBlock(params.crusherLevels, numSamples);
+
+    const double modulationRate = updateModulation(params);
+    transportBeats += (double)numSamples * transportBpm / (60.0 * currentSampleRate);
+
+    // Checked against this chunk's own input, so the first chunk with signal
+    // is always processed in full
+    const bool gateClosed = isGateClosed(buffer, startSample, numSamples, numChannels, params);
+
+    // The gate must have been closed for the whole tail, so the filters have
+    // rung out, not just the latency
+    if (gateClosed && params.jitter == 0.0f && outputSilent && closedGateSamples >= getTailLengthInSamples())
+    {
+        if (! skippingSilence)
+            clearSignalState();
+
+        skippingSilence = true;
+        skipSilentChunk(buffer, startSample, numSamples, numChannels, params, ramps);
+        modulator.advance(numSamples, modulationRate);
+        noise.advance(numSamples);
+        return;
+    }
+
+    // The LFO runs with the clock, so a chunk that does not use it still moves it on
+    if (params.bitModulation > 0.0f)
+        ramps.modulation = modulator.getNextBlock(numSamples, modulationRate, params.modulationShape);
+    else
+        modulator.advance(numSamples, modulationRate);
+
+    skippingSilence = false;
+    processActiveChunk(buffer, startSample, numSamples, numChannels, params, ramps);
+    noise.advance(numSamples);
+    updateTail();
+
+    closedGateSamples = gateClosed ? juce::jmin(closedGateSamples + numSamples, 1 << 30) : 0;
+    outputSilent = true;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        if (buffer.getMagnitude(channel, startSample, numSamples) >= silenceLevel)
+            outputSilent = false;
+}
+
+template <typename SampleType>
+double DistortionEngine<SampleType>::updateModulation(const Parameters& params) noexcept
+{
+    if (! params.modulationSync)
+        return params.modulationRate;
+
+    // Phase-locked to the bar while the host plays, so every pass through a
+    // section sounds the same; a stopped transport keeps the synced rate only
+    if (transportPlaying)
+        modulator.setPhase(transportBeats / params.modulationBeats);
+
+    return transportBpm / (60.0 * params.modulationBeats);
+}
+
+template <typename SampleType>
+bool DistortionEngine<SampleType>::isGateClosed(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                                    int numChannels, const Parameters& params) const
+{
+    // The envelope is a convex blend of its previous value and the input, so
+    // if neither rises above the threshold the gate cannot open during this
+    // chunk. M/S encoding never raises the peak, so the L/R peak is enough.
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        if (channelState.envelope[channel] > params.threshold
+            || buffer.getMagnitude(channel, startSample, numSamples) > params.threshold)
+            return false;
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::skipSilentChunk(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                                       int numChannels, const Parameters& params, const Ramps& ramps)
+{
+    // Every stage after the gate would only see zeros, so output silence and
+    // move the free-running state on as if it had run. The envelopes still
+    // follow the sub-threshold input through the same encode and gate as a
+    // processed chunk, so the gate opens on the same sample either way.
+    const auto& pairs = midSidePairs[(size_t)params.midSidePairs];
+
+    for (const auto& pair : pairs)
+        if (pair.left < numChannels && pair.right < numChannels)
+            midSideEncode(buffer.getWritePointer(pair.left, startSample), buffer.getWritePointer(pair.right, startSample),
+                          numSamples, params.midSide, ramps.midSide);
+
+    if (numChannels > 1)
+        processGateLanes(buffer, startSample, numSamples, numChannels, params);
+    else
+        processGate(buffer.getWritePointer(0, startSample), numSamples, 0, params);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        buffer.clear(channel, startSample, numSamples);
+        channelState.sampleCount[channel] += numSamples;
+    }
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::clearSignalState()
+{
+    // Whatever is left in the filters, delay lines and holds is below the
+    // silence level by now, but the first chunk after the skip would still
+    // play it out from where it stopped, however long ago that was
+    channelState.clearSignalState();
+
+    if (activeOversampler != nullptr)
+        activeOversampler->reset();
+
+    frequencyShifter.reset();
+    spectralShifter.reset();
+    cleanDelay.reset();
+    dryDelay.reset();
+    wetDelay.reset();
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processActiveChunk(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                                          int numChannels, const Parameters& params, const Ramps& ramps)
+{
+    const auto& pairs = midSidePairs[(size_t)params.midSidePairs];
+
+    // The fused loop encodes channels 0 and 1
+    if (numChannels == 2 && pairs.size() == 1 && pairs[0].left == 0 && pairs[0].right == 1
+        && activeOversampler == nullptr && spectralMode == SpectralMode::frequencyShifter)
+    {
+        processStereoChunk(buffer.getWritePointer(0, startSample), buffer.getWritePointer(1, startSample),
+                           numSamples, params, ramps);
+        return;
+    }
+
+    // A host may run fewer channels than were prepared
+    auto isActivePair = [numChannels] (const ChannelPair& pair) { return pair.left < numChannels && pair.right < numChannels; };
+
+    for (const auto& pair : pairs)
+        if (isActivePair(pair))
+            midSideEncode(buffer.getWritePointer(pair.left, startSample), buffer.getWritePointer(pair.right, startSample),
+                          numSamples, params.midSide, ramps.midSide);
+
+    if (numChannels > 1)
+        processGateLanes(buffer, startSample, numSamples, numChannels, params);
+    else
+        processGate(buffer.getWritePointer(0, startSample), numSamples, 0, params);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* clean = buffer.getWritePointer(channel, startSample);
+        auto* distorted = distortedBuffer.getWritePointer(channel);
+
+        // Drive is applied here, at the base rate, so its ramp lines up with
+        // the block whether or not the shaper is oversampled
+        if (ramps.drive != nullptr)
+            juce::FloatVectorOperations::multiply(distorted, clean, ramps.drive, numSamples);
+        else
+            juce::FloatVectorOperations::copyWithMultiply(distorted, clean, (SampleType)params.drive, numSamples);
+
+        processCrusher(clean, crushedBuffer.getWritePointer(channel), numSamples, channel, params, ramps);
+    }
+
+    // All channels at once, one SIMD lane each
+    if (spectralMode == SpectralMode::frequencyShifter)
+        frequencyShifter.process(crushedBuffer.getArrayOfWritePointers(), numChannels, numSamples, params.spectralShift);
+
+    processShaperStage(numSamples, numChannels, params);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        processMix(buffer.getWritePointer(channel, startSample), distortedBuffer.getWritePointer(channel),
+                   crushedBuffer.getReadPointer(channel), numSamples, channel, params.mix, ramps.mix);
+
+    for (const auto& pair : pairs)
+        if (isActivePair(pair))
+            midSideDecode(buffer.getWritePointer(pair.left, startSample), buffer.getWritePointer(pair.right, startSample),
+                          numSamples);
+}
+
+template <typename SampleType>
+int DistortionEngine<SampleType>::getCrusherFeatures(const Parameters& params, const SampleType* levelsRamp) noexcept
+{
+    return (params.downsample > 1.0f ? downsamplingFeature : 0)
+         | (params.bitModulation > 0.0f ? modulationFeature : 0)
+         | (params.jitter > 0.0f ? jitterFeature : 0)
+         | (levelsRamp != nullptr ? levelsRampFeature : 0);
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processStereoChunk(SampleType* left, SampleType* right, int numSamples,
+                                                      const Parameters& params, const Ramps& ramps)
+{
+    static constexpr auto stereoKernels = makeStereoKernels(std::make_integer_sequence<int, numStereoKernels>());
+
+    // The frequency shifter runs across both channels at once, so a shifted
+    // crushed signal is written out and added back after the loop
+    const int features = getCrusherFeatures(params, ramps.crusherLevels)
+                       | (params.shaperMode == ShaperMode::direct && kernels->instructionSet == VectorKernels::InstructionSet::reference
+                              ? inlineShaperFeature : 0)
+                       | (params.spectralShift == 0.0f ? inlineCrusherFeature : 0);
+
+    // The inline crusher skips the shifter entirely; still tell it the shift
+    // is off so it restarts from a clean state when it is turned back on
+    if (params.spectralShift == 0.0f)
+    {
+        SampleType* const channels[] { left, right };
+        frequencyShifter.process(channels, 2, numSamples, 0.0f);
+    }
+
+    (this->*stereoKernels[(size_t)features])(left, right, numSamples, params, ramps);
+}
+
+template <typename SampleType>
+template <int Features>
+void DistortionEngine<SampleType>::processStereoKernel(SampleType* left, SampleType* right, int numSamples,
+                                                       const Parameters& params, const Ramps& ramps)
+{
+    constexpr bool downsampling = (Features & downsamplingFeature) != 0;
+    constexpr bool modulating = (Features & modulationFeature) != 0;
+    constexpr bool jittering = (Features & jitterFeature) != 0;
+    constexpr bool rampedLevels = (Features & levelsRampFeature) != 0;
+    constexpr bool inlineShaper = (Features & inlineShaperFeature) != 0;
+    constexpr bool inlineCrusher = (Features & inlineCrusherFeature) != 0;
+
+    // The remaining ramps are read with stride 1 and a static value with
+    // stride 0, so the loop has no per-parameter branch
+    const SampleType staticValues[] = { params.midSide, params.drive, params.mix };
+    const SampleType* midSide = ramps.midSide != nullptr ? ramps.midSide : &staticValues[0];
+    const SampleType* drive = ramps.drive != nullptr ? ramps.drive : &staticValues[1];
+    const SampleType* mix = ramps.mix != nullptr ? ramps.mix : &staticValues[2];
+    const int midSideStride = ramps.midSide != nullptr ? 1 : 0;
+    const int driveStride = ramps.drive != nullptr ? 1 : 0;
+    const int mixStride = ramps.mix != nullptr ? 1 : 0;
+
+    const ShaperCurve<SampleType> curve(params.saturation);
+    const int downsampleStep = juce::jmax(1, static_cast<int>(params.downsample));
+
+    SampleType* distorted[2] = { distortedBuffer.getWritePointer(0), distortedBuffer.getWritePointer(1) };
+    SampleType* crushedOut[2] = { crushedBuffer.getWritePointer(0), crushedBuffer.getWritePointer(1) };
+    const float* jitterNoise[2] = { noiseBuffer.getReadPointer(0), noiseBuffer.getReadPointer(1) };
+
+    if constexpr (jittering)
+        for (int channel = 0; channel < 2; ++channel)
+            noise.fill(noiseBuffer.getWritePointer(channel), numSamples, channel);
+
+    SampleType envelope[2] = { channelState.envelope[0], channelState.envelope[1] };
+    SampleType heldSample[2] = { channelState.heldSample[0], channelState.heldSample[1] };
+    // Position within the downsample period, so the loop needs no 64-bit division
+    int downsamplePhase[2] = { (int)(channelState.sampleCount[0] % downsampleStep),
+                               (int)(channelState.sampleCount[1] % downsampleStep) };
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Encode, with the same operation order as midSideEncode()
+        const SampleType ratio = midSide[i * midSideStride];
+        const SampleType encoded[2] = { (left[i] + right[i]) * SampleType(0.5) * (SampleType(1) - ratio),
+                                        (left[i] - right[i]) * SampleType(0.5) * ratio };
+        const SampleType mixAmount = mix[i * mixStride];
+        SampleType mixed[2];
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            SampleType sample = encoded[channel];
+
+            // Gate
+            const SampleType level = std::abs(sample);
+            const SampleType coeff = (level > envelope[channel]) ? params.attackCoeff : params.releaseCoeff;
+            envelope[channel] = level + coeff * (envelope[channel] - level);
+            sample = (envelope[channel] > params.threshold) ? sample : SampleType(0);
+
+            // Crusher; held samples bypass the chain
+            if constexpr (downsampling)
+                if (++downsamplePhase[channel] == downsampleStep)
+                    downsamplePhase[channel] = 0;
+
+            SampleType crushed = heldSample[channel];
+
+            if (! downsampling || downsamplePhase[channel] == 0)
+            {
+                if constexpr (downsampling)
+                    heldSample[channel] = sample;
+
+                const SampleType maxValue = rampedLevels ? ramps.crusherLevels[i] : (SampleType)params.crusherLevels;
+                crushed = std::floor(sample * maxValue) / maxValue;
+
+                if constexpr (modulating)
+                    crushed *= 1.0f + ramps.modulation[i] * params.bitModulation;
+
+                if constexpr (jittering)
+                    crushed += jitterNoise[channel][i] * params.jitter * 0.1f;
+
+                crushed = juce::jlimit(SampleType(-1), SampleType(1), crushed);
+            }
+
+            if constexpr (inlineCrusher)
+            {
+                mixed[channel] = sample * (SampleType(1) - mixAmount) + crushed * (mixAmount * SampleType(0.5));
+            }
+            else
+            {
+                mixed[channel] = sample * (SampleType(1) - mixAmount);
+                crushedOut[channel][i] = crushed;
+            }
+
+            // Drive and shape
+            const SampleType driven = sample * drive[i * driveStride];
+
+            if constexpr (inlineShaper)
+                mixed[channel] += curve(driven) * (mixAmount * SampleType(0.5));
+            else
+                distorted[channel][i] = driven;
+        }
+
+        if constexpr (inlineShaper && inlineCrusher)
+        {
+            left[i] = mixed[0] + mixed[1];
+            right[i] = mixed[0] - mixed[1];
+        }
+        else
+        {
+            left[i] = mixed[0];
+            right[i] = mixed[1];
+        }
+    }
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        channelState.envelope[channel] = envelope[channel];
+        channelState.heldSample[channel] = heldSample[channel];
+        channelState.sampleCount[channel] += numSamples;
+    }
+
+    if constexpr (! (inlineShaper && inlineCrusher))
+    {
+        // The ADAA and table shapers and the frequency shifter work on whole
+        // blocks: run them, then add their output and decode in a second pass
+        if constexpr (! inlineShaper)
+            for (int channel = 0; channel < 2; ++channel)
+                processShaper(distorted[channel], numSamples, channel, params);
+
+        if constexpr (! inlineCrusher)
+            frequencyShifter.process(crushedOut, 2, numSamples, params.spectralShift);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType wet = mix[i * mixStride] * SampleType(0.5);
+            SampleType mid = left[i];
+            SampleType side = right[i];
+
+            if constexpr (! inlineCrusher)
+            {
+                mid += crushedOut[0][i] * wet;
+                side += crushedOut[1][i] * wet;
+            }
+
+            if constexpr (! inlineShaper)
+            {
+                mid += distorted[0][i] * wet;
+                side += distorted[1][i] * wet;
+            }
+
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+    }
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::midSideEncode(SampleType* left, SampleType* right, int numSamples, float midSideRatio,
+                                                 const SampleType* midSideRamp)
+{
+    // The two scalings are kept separate so the gate and quantiser see
+    // bit-identical input to the old per-sample path
+    if (midSideRamp != nullptr)
+        kernels->midSideEncodeRamp(left, right, numSamples, midSideRamp);
+    else
+        kernels->midSideEncode(left, right, numSamples, midSideRatio);
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::midSideDecode(SampleType* mid, SampleType* side, int numSamples)
+{
+    kernels->midSideDecode(mid, side, numSamples);
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processGate(SampleType* data, int numSamples, int channel, const Parameters& params)
+{
+    // The envelope is a one-pole recursion, so this stage stays serial; the
+    // gate itself is a select rather than a branch
+    SampleType env = channelState.envelope[channel];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const SampleType input = std::abs(data[i]);
+        const SampleType coeff = (input > env) ? params.attackCoeff : params.releaseCoeff;
+        env = input + coeff * (env - input);
+        data[i] = (env > params.threshold) ? data[i] : SampleType(0);
+    }
+
+    channelState.envelope[channel] = env;
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processGateLanes(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                                                    int numChannels, const Parameters& params)
+{
+    // Same operations as processGate(), with one channel per SIMD lane
+    // instead of one channel at a time, since the envelope is serial in time
+    using Lanes = juce::dsp::SIMDRegister<SampleType>;
+    const int laneCount = (int)Lanes::size();
+
+    const auto attack = Lanes::expand(params.attackCoeff);
+    const auto release = Lanes::expand(params.releaseCoeff);
+    const auto threshold = Lanes::expand(params.threshold);
+
+    alignas(Lanes::SIMDRegisterSize) SampleType frame[Lanes::SIMDNumElements] = {};
+    SampleType* channels[Lanes::SIMDNumElements] = {};
+
+    for (int first = 0; first < numChannels; first += laneCount)
+    {
+        const int count = juce::jmin(laneCount, numChannels - first);
+
+        for (int lane = 0; lane < count; ++lane)
+            channels[lane] = buffer.getWritePointer(first + lane, startSample);
+
+        // State lanes are cache-line aligned and padded past the last
+        // channel, so a partial group reads and writes padding only
+        auto envelope = Lanes::fromRawArray(channelState.envelope + first);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int lane = 0; lane < count; ++lane)
+                frame[lane] = channels[lane][i];
+
+            const auto input = Lanes::fromRawArray(frame);
+            const auto level = Lanes::abs(input);
+            const auto rising = Lanes::greaterThan(level, envelope);
+            const auto coeff = (attack & rising) + (release & ~rising);
+            envelope = level + coeff * (envelope - level);
+
+            (input & Lanes::greaterThan(envelope, threshold)).copyToRawArray(frame);
+
+            for (int lane = 0; lane < count; ++lane)
+                channels[lane][i] = frame[lane];
+        }
+
+        envelope.copyToRawArray(channelState.envelope + first);
+    }
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processShaperStage(int numSamples, int numChannels, const Parameters& params)
+{
+    // distortedBuffer holds the driven signal on entry and the shaped signal
+    // on exit
+    if (activeOversampler == nullptr)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            processShaper(distortedBuffer.getWritePointer(channel), numSamples, channel, params);
+
+        return;
+    }
+
+    juce::dsp::AudioBlock<SampleType> block(distortedBuffer.getArrayOfWritePointers(), (size_t)numChannels, (size_t)numSamples);
+    auto oversampledBlock = activeOversampler->processSamplesUp(block);
+
+    for (size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
+        processShaper(oversampledBlock.getChannelPointer(channel), (int)oversampledBlock.getNumSamples(),
+                      (int)channel, params);
+
+    activeOversampler->processSamplesDown(block);
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processShaper(SampleType* data, int numSamples, int channel, const Parameters& params)
+{
+    // data is already driven. The table is an approximation, so offline
+    // renders evaluate the curve instead.
+    if (params.shaperMode == ShaperMode::lookupTable && ! offlineRendering)
+    {
+        shaperTable->process(data, numSamples, params.saturation, *kernels);
+        return;
+    }
+
+    if (params.shaperMode != ShaperMode::direct)
+    {
+        adaaShaper.process(data, numSamples, params.shaperMode == ShaperMode::adaa2 ? 2 : 1, params.saturation,
+                           channelState.adaaHistory1[channel], channelState.adaaHistory2[channel]);
+        return;
+    }
+
+    kernels->shape(data, numSamples, ShaperCurve<SampleType>(params.saturation));
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processCrusher(const SampleType* input, SampleType* output, int numSamples, int channel,
+                                                  const Parameters& params, const Ramps& ramps)
+{
+    static constexpr auto crusherKernels = makeCrusherKernels(std::make_integer_sequence<int, numCrusherKernels>());
+
+    (this->*crusherKernels[(size_t)getCrusherFeatures(params, ramps.crusherLevels)])(input, output, numSamples, channel, params, ramps);
+
+    // Runs even at zero shift so the latency stays constant. The frequency
+    // shifter runs across all channels once every channel has been crushed.
+    if (spectralMode == SpectralMode::stft)
+        spectralShifter.process(output, numSamples, channel, params.spectralShift);
+}
+
+template <typename SampleType>
+template <int Features>
+void DistortionEngine<SampleType>::processCrusherKernel(const SampleType* input, SampleType* output, int numSamples,
+                                                        int channel, const Parameters& params, const Ramps& ramps)
+{
+    constexpr bool downsampling = (Features & downsamplingFeature) != 0;
+    constexpr bool modulating = (Features & modulationFeature) != 0;
+    constexpr bool jittering = (Features & jitterFeature) != 0;
+    constexpr bool rampedLevels = (Features & levelsRampFeature) != 0;
+
+    auto* mask = holdMask.data();
+    auto* held = holdValues.data();
+
+    // Sample-and-hold. Held samples bypass the rest of the chain, so the hold
+    // pattern is resolved here in one serial pass; without downsampling there
+    // is nothing to resolve.
+    SampleType lastSample = channelState.heldSample[channel];
+
+    if constexpr (downsampling)
+    {
+        const int downsampleStep = juce::jmax(1, static_cast<int>(params.downsample));
+
+        // Position within the period, so the loop needs no 64-bit division
+        int phase = (int)(channelState.sampleCount[channel] % downsampleStep);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (++phase == downsampleStep)
+                phase = 0;
+
+            const bool hold = phase != 0;
+            lastSample = hold ? lastSample : input[i];
+            mask[i] = hold ? SampleType(1) : SampleType(0);
+            held[i] = lastSample;
+        }
+    }
+
+    channelState.heldSample[channel] = lastSample;
+    channelState.sampleCount[channel] += numSamples;
+
+    // Bit depth reduction
+    if constexpr (rampedLevels)
+        kernels->quantizeRamp(input, output, numSamples, ramps.crusherLevels);
+    else
+        kernels->quantize(input, output, numSamples, params.crusherLevels);
+
+    // Modulation and jitter; held samples are replaced below, so they can take them too
+    if constexpr (modulating)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] *= 1.0f + ramps.modulation[i] * params.bitModulation;
+    }
+
+    if constexpr (jittering)
+    {
+        auto* jitterNoise = noiseBuffer.getWritePointer(channel);
+        noise.fill(jitterNoise, numSamples, channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            output[i] += jitterNoise[i] * params.jitter * 0.1f;
+    }
+
+    // Normalize output
+    juce::FloatVectorOperations::clip(output, output, SampleType(-1), SampleType(1), numSamples);
+
+    // Held samples output the raw held value
+    if constexpr (downsampling)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = (mask[i] != SampleType(0)) ? held[i] : output[i];
+    }
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processDelay(DelayLine& delay, SampleType* data, int numSamples, int channel)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        delay.pushSample(channel, data[i]);
+        data[i] = delay.popSample(channel);
+    }
+}
+
+template <typename SampleType>
+void DistortionEngine<SampleType>::processMix(SampleType* clean, SampleType* distorted, const SampleType* crushed,
+                                              int numSamples, int channel, float mix, const SampleType* mixRamp)
+{
+    // The crushed path already carries the spectral shifter latency
+    if (cleanDelaySamples > 0)
+        processDelay(cleanDelay, clean, numSamples, channel);
+
+    // clean * (1 - mix) + (distorted + crushed) * mix * 0.5
+    if (mixRamp != nullptr)
+        kernels->mixRamp(clean, crushed, numSamples, mixRamp);
+    else
+        kernels->mix(clean, crushed, numSamples, mix);
+
+    // Bring both sides up to the total latency
+    if (dryDelaySamples > 0)
+        processDelay(dryDelay, clean, numSamples, channel);
+
+    if (wetDelaySamples > 0)
+        processDelay(wetDelay, distorted, numSamples, channel);
+
+    if (mixRamp != nullptr)
+        kernels->addWetRamp(clean, distorted, numSamples, mixRamp);
+    else
+        kernels->addWet(clean, distorted, numSamples, mix);
+}
+
+template class DistortionEngine<float>;
+template class DistortionEngine<double>;
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "AdaaShaper.h"
+#include "ChannelStateBlock.h"
+#include "ParameterRamp.h"
+#include "ShaperTable.h"
+#include "FrequencyShifter.h"
+#include "ModulationOscillator.h"
+#include "NoiseGenerator.h"
+#include "SpectralShifter.h"
+#include "VectorKernels.h"
+
+// Block-based DSP core for the processor. Every stage runs over a chunk of at
+// most chunkSize samples per channel; DistortionEngineBase holds the
+// parameters, modes and constants shared by the float and double engines.
+class DistortionEngineBase
+{
+public:
+    // How the saturation curve is evaluated
+    enum class ShaperMode
+    {
+        direct = 0,
+        adaa1,      // First-order antiderivative anti-aliasing
+        adaa2,      // Second-order antiderivative anti-aliasing
+        lookupTable // Interpolated table shared by all instances
+    };
+
+    // How Spectral Shift acts on the crushed path
+    enum class SpectralMode
+    {
+        frequencyShifter = 0,   // Hilbert single-sideband shift, no latency
+        stft                    // Overlap-add bin shift, adds SpectralShifter latency
+    };
+
+    // Channel pairs the Mid/Side stage encodes
+    enum class MidSidePairs
+    {
+        off = 0,
+        front,      // Front left/right only
+        all         // Every left/right pair in the layout
+    };
+
+    struct ChannelPair
+    {
+        int left = 0;
+        int right = 1;
+    };
+
+    struct Parameters
+    {
+        float drive = 5.0f;
+        float mix = 0.5f;
+        float saturation = 0.7f;
+        float midSide = 0.5f;
+        float threshold = 0.01f;    // Linear gain, not dB
+        float attackCoeff = 0.0f;
+        float releaseCoeff = 0.0f;
+        float crusherLevels = 65535.0f;    // 2^bitDepth - 1
+        float bitModulation = 0.0f;
+        float modulationRate = 700.0f;      // Hz, when not synced
+        ModulationOscillator::Shape modulationShape = ModulationOscillator::Shape::sine;
+        bool modulationSync = false;
+        double modulationBeats = 0.25;      // Quarter notes per cycle, when synced
+        float spectralShift = 0.0f;
+        float downsample = 1.0f;
+        float jitter = 0.0f;
+        ShaperMode shaperMode = ShaperMode::direct;
+        MidSidePairs midSidePairs = MidSidePairs::front;
+    };
+
+    // Drive, mix, M/S ratio and quantizer levels glide over this time
+    static constexpr double rampTimeSeconds = 0.02;
+
+    // Oversampling for the shaper stage: order 0 = 1x ... maxOversamplingOrder = 16x
+    static constexpr int maxOversamplingOrder = 4;
+
+    static constexpr float silenceLevel = 1.0e-6f;         // -120 dBFS
+    static constexpr int oversamplingTailSamples = 512;     // IIR half-band ringing, at the base rate
+
+    // Internal block length. Every stage runs on at most this many samples,
+    // whatever the host block size; host blocks are split in place, so this
+    // adds no latency. Even at 16x a chunk is 4 kB per float channel, so the
+    // scratch buffers stay in L1.
+    static constexpr int chunkSize = 64;
+
+    // Widest bus accepted; seventh-order ambisonics
+    static constexpr int maxChannels = 64;
+
+    // Speaker pairs of a layout: matching left/right channel types, or
+    // neighbouring channels of a discrete layout. Ambisonic layouts have none.
+    static std::vector<ChannelPair> findMidSidePairs(const juce::AudioChannelSet& layout, MidSidePairs mode);
+};
+
+// Instantiated for float and double, so double-precision hosts are processed
+// without conversion. The LFO, the jitter noise and the STFT shifter stay float.
+template <typename SampleType>
+class DistortionEngine : public DistortionEngineBase
+{
+public:
+    DistortionEngine() = default;
+
+    // Allocates all scratch buffers; nothing is allocated in process(). The
+    // layout sets the channel count and the Mid/Side pairs. The host block
+    // size does not matter, since processing runs in chunkSize chunks.
+    void prepare(double sampleRate, const juce::AudioChannelSet& layout);
+    void reset();
+
+    void process(juce::AudioBuffer<SampleType>& buffer, int numChannels, const Parameters& params);
+
+    // Factor and filter chosen by the user; offline rendering overrides the factor
+    void setOversampling(int order, bool linearPhase);
+
+    // Offline bounces trade CPU for quality: the highest oversampling factor,
+    // the exact reference kernels, the curve itself instead of the lookup
+    // table. Switching resets
+    // the engine and changes the latency, so the caller re-reads
+    // getLatencyInSamples() afterwards.
+    void setOfflineRendering(bool shouldRenderOffline);
+    bool isRenderingOffline() const noexcept { return offlineRendering; }
+
+    void setSpectralMode(SpectralMode mode);
+
+    // Seed of the jitter noise; streams restart from the beginning on reset().
+    // Cheap and allocation free, so it can follow the parameters per block.
+    void setNoiseSeed(juce::uint32 seed) { noise.setSeed(seed); }
+    juce::uint32 getNoiseSeed() const noexcept { return noise.getSeed(); }
+
+    // Host tempo and beat position at the start of the next process() call,
+    // for tempo-synced Bit Modulation. Without a playing transport the synced
+    // rate still follows bpm but the phase runs free. When rendering offline,
+    // the transport starting resets the engine, so the jitter noise, the LFO
+    // and the downsample phase start from zero and every bounce is identical.
+    void setTransport(double bpm, double ppqPosition, bool isPlaying) noexcept;
+
+    int getLatencyInSamples() const noexcept { return latencySamples; }
+
+    // Samples until the output is silent after the input stops. Safe to call
+    // from any thread.
+    int getTailLengthInSamples() const noexcept { return tailSamples.load(std::memory_order_relaxed); }
+
+private:
+    // Per-chunk ramps; nullptr for parameters that are not moving
+    struct Ramps
+    {
+        const SampleType* drive = nullptr;
+        const SampleType* mix = nullptr;
+        const SampleType* midSide = nullptr;
+        const SampleType* crusherLevels = nullptr;
+        const float* modulation = nullptr;  // Bit Modulation LFO, only rendered while in use
+    };
+
+    void processChunk(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                      int numChannels, const Parameters& params);
+    void processActiveChunk(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                            int numChannels, const Parameters& params, const Ramps& ramps);
+
+    // Silence fast path. Once the gate has been closed for the whole tail and
+    // the output is below silenceLevel, chunks are skipped: the output is
+    // cleared, the gate envelopes keep following the input and the
+    // free-running counters move on. Signal state is cleared as the skip
+    // begins. Jitter disables it, since it adds noise to silence.
+    bool isGateClosed(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                      int numChannels, const Parameters& params) const;
+    void skipSilentChunk(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                         int numChannels, const Parameters& params, const Ramps& ramps);
+    void clearSignalState();
+
+    // Features the kernels are specialised on. Each combination is its own
+    // instantiation, so a disabled feature costs nothing inside the loop.
+    enum KernelFeature
+    {
+        downsamplingFeature = 1 << 0,
+        modulationFeature = 1 << 1,
+        jitterFeature = 1 << 2,
+        levelsRampFeature = 1 << 3,
+        inlineShaperFeature = 1 << 4,   // Stereo only: direct shaper runs in the fused loop
+        inlineCrusherFeature = 1 << 5   // Stereo only: no frequency shift on the crushed path
+    };
+
+    static constexpr int numCrusherKernels = 1 << 4;
+    static constexpr int numStereoKernels = 1 << 6;
+
+    static int getCrusherFeatures(const Parameters& params, const SampleType* levelsRamp) noexcept;
+
+    using CrusherKernel = void (DistortionEngine::*)(const SampleType*, SampleType*, int, int, const Parameters&, const Ramps&);
+    using StereoKernel = void (DistortionEngine::*)(SampleType*, SampleType*, int, const Parameters&, const Ramps&);
+
+    template <int... Features>
+    static constexpr std::array<CrusherKernel, sizeof...(Features)> makeCrusherKernels(std::integer_sequence<int, Features...>) noexcept
+    {
+        return { { &DistortionEngine::processCrusherKernel<Features>... } };
+    }
+
+    template <int... Features>
+    static constexpr std::array<StereoKernel, sizeof...(Features)> makeStereoKernels(std::integer_sequence<int, Features...>) noexcept
+    {
+        return { { &DistortionEngine::processStereoKernel<Features>... } };
+    }
+
+    // Single-pass stereo path, used when the shaper is not oversampled: loads
+    // L/R once and runs M/S, gate, drive, crusher, mix and decode per sample.
+    // The direct shaper runs inline with the reference kernels; the other
+    // shapers and the frequency shifter add a block pass.
+    void processStereoChunk(SampleType* left, SampleType* right, int numSamples, const Parameters& params, const Ramps& ramps);
+
+    template <int Features>
+    void processStereoKernel(SampleType* left, SampleType* right, int numSamples, const Parameters& params, const Ramps& ramps);
+
+    // Mid-Side stages, once per channel pair
+    void midSideEncode(SampleType* left, SampleType* right, int numSamples, float midSideRatio, const SampleType* midSideRamp);
+    void midSideDecode(SampleType* mid, SampleType* side, int numSamples);
+
+    // Per-block stages. With several channels, processGateLanes runs the
+    // serial gate envelope across channels instead, one SIMD lane each.
+    void processGate(SampleType* data, int numSamples, int channel, const Parameters& params);
+    void processGateLanes(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples, int numChannels,
+                          const Parameters& params);
+    void processShaperStage(int numSamples, int numChannels, const Parameters& params);
+    void processShaper(SampleType* data, int numSamples, int channel, const Parameters& params);
+    void processCrusher(const SampleType* input, SampleType* output, int numSamples, int channel,
+                        const Parameters& params, const Ramps& ramps);
+
+    template <int Features>
+    void processCrusherKernel(const SampleType* input, SampleType* output, int numSamples, int channel,
+                              const Parameters& params, const Ramps& ramps);
+    void processMix(SampleType* clean, SampleType* distorted, const SampleType* crushed, int numSamples, int channel,
+                    float mix, const SampleType* mixRamp);
+
+    // Syncs the LFO to the transport and returns its rate for this chunk
+    double updateModulation(const Parameters& params) noexcept;
+
+    // Recomputes the total latency and the path delays that keep the clean,
+    // crushed and shaped paths aligned
+    void updateLatency();
+
+    // Publishes the tail for the current latency and frequency shifter state
+    void updateTail() noexcept;
+
+    using DelayLine = juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None>;
+
+    static void processDelay(DelayLine& delay, SampleType* data, int numSamples, int channel);
+
+    static int getOversamplerIndex(int order, bool linearPhase) { return (linearPhase ? maxOversamplingOrder : 0) + order - 1; }
+
+    double currentSampleRate = 44100.0;
+    int preparedChannels = 0;
+
+    // Mid/Side pairs of the prepared layout, indexed by MidSidePairs
+    std::array<std::vector<ChannelPair>, 3> midSidePairs;
+
+    // One oversampler per factor and filter type, built in prepare()
+    std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, 2 * maxOversamplingOrder> oversamplers;
+    juce::dsp::Oversampling<SampleType>* activeOversampler = nullptr;
+    int requestedOversamplingOrder = 0;
+    int oversamplingOrder = 0;
+    bool oversamplingLinearPhase = false;
+    int oversamplingLatency = 0;
+    int latencySamples = 0;
+    int baseTailSamples = 0;
+    std::atomic<int> tailSamples { 0 };
+    int cleanDelaySamples = 0;
+    int dryDelaySamples = 0;
+    int wetDelaySamples = 0;
+
+    FrequencyShifter<SampleType> frequencyShifter;
+    SpectralShifter spectralShifter;
+    SpectralMode spectralMode = SpectralMode::frequencyShifter;
+
+    ParameterRamp<SampleType> driveRamp;
+    ParameterRamp<SampleType> mixRamp;
+    ParameterRamp<SampleType> midSideRamp;
+    ParameterRamp<SampleType> crusherLevelsRamp;
+
+    // Instruction set chosen in prepare(); see VectorKernels
+    const VectorKernels::Table<SampleType>* kernels = nullptr;
+
+    bool offlineRendering = false;
+
+    AdaaShaper adaaShaper;
+    juce::SharedResourcePointer<ShaperTable> shaperTable;
+
+    // Path alignment: cleanDelay matches the clean path to the spectral
+    // shifter, then dryDelay (clean + crushed) and wetDelay (shaped) bring
+    // both sides up to the total latency
+    DelayLine cleanDelay;
+    DelayLine dryDelay;
+    DelayLine wetDelay;
+
+    juce::AudioBuffer<SampleType> distortedBuffer;
+    juce::AudioBuffer<SampleType> crushedBuffer;
+
+    // Single-channel scratch reused by the stages
+    std::vector<SampleType> holdMask;
+    std::vector<SampleType> holdValues;
+
+    // Gate, crusher and ADAA state, one lane per channel
+    ChannelStateBlock<SampleType> channelState;
+
+    int closedGateSamples = 0;      // Consecutive samples with the gate closed on every channel
+    bool outputSilent = false;      // Last processed chunk stayed below silenceLevel
+    bool skippingSilence = false;   // Signal state was cleared when the skip began
+
+    // Bit Modulation LFO, shared by every channel
+    ModulationOscillator modulator;
+    double transportBpm = 120.0;
+    double transportBeats = 0.0;    // Quarter notes at the start of the next chunk
+    bool transportPlaying = false;
+
+    NoiseGenerator noise;
+    juce::AudioBuffer<float> noiseBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DistortionEngine)
+};
@@ -0,0 +1,132 @@
+#include "FrequencyShifter.h"
+
+namespace
+{
+    // Squared allpass coefficients (Niemitalo's 8th-order pair)
+    template <typename SampleType>
+    constexpr SampleType pathACoefficients[] = { SampleType(0.4794008656), SampleType(0.8762184935),
+                                                 SampleType(0.9765975895), SampleType(0.9974992559) };
+
+    template <typename SampleType>
+    constexpr SampleType pathBCoefficients[] = { SampleType(0.1617584984), SampleType(0.7330289323),
+                                                 SampleType(0.9453497003), SampleType(0.9905991567) };
+}
+
+template <typename SampleType>
+void FrequencyShifter<SampleType>::prepare(int maximumBlockSize, int numChannels)
+{
+    const int laneCount = (int)Lanes::size();
+    groups.resize((size_t)((juce::jmax(1, numChannels) + laneCount - 1) / laneCount));
+
+    oscillatorCos.assign((size_t)juce::jmax(1, maximumBlockSize), SampleType(0));
+    oscillatorSin.assign((size_t)juce::jmax(1, maximumBlockSize), SampleType(0));
+
+    reset();
+}
+
+template <typename SampleType>
+void FrequencyShifter<SampleType>::reset()
+{
+    const auto zero = Lanes::expand(SampleType(0));
+
+    for (auto& group : groups)
+    {
+        for (int section = 0; section < numSections; ++section)
+            group.pathA[section] = group.pathB[section] = { zero, zero, zero, zero };
+
+        group.delayedA = zero;
+    }
+
+    phaseCos = 1.0;
+    phaseSin = 0.0;
+}
+
+template <typename SampleType>
+typename FrequencyShifter<SampleType>::Lanes FrequencyShifter<SampleType>::processPath(AllpassSection* sections,
+                                                                                      const SampleType* coefficients,
+                                                                                      Lanes input) noexcept
+{
+    // y[n] = c * (x[n] + y[n-2]) - x[n-2], per section
+    for (int section = 0; section < numSections; ++section)
+    {
+        auto& state = sections[section];
+        const auto output = (input + state.y2) * coefficients[section] - state.x2;
+
+        state.x2 = state.x1;
+        state.x1 = input;
+        state.y2 = state.y1;
+        state.y1 = output;
+
+        input = output;
+    }
+
+    return input;
+}
+
+template <typename SampleType>
+void FrequencyShifter<SampleType>::process(SampleType* const* channels, int numChannels, int numSamples, float shift) noexcept
+{
+    if (shift == 0.0f)
+    {
+        active = false;
+        return;
+    }
+
+    // Start from a clean state rather than whatever was left when the shift was last at zero
+    if (! active)
+    {
+        reset();
+        active = true;
+    }
+
+    jassert(numSamples <= (int)oscillatorCos.size());
+
+    // Rotation recurrence in double; renormalised once per block
+    const double delta = (double)juce::jlimit(-1.0f, 1.0f, shift) * maxShiftPerSample;
+    const double rotationCos = std::cos(delta);
+    const double rotationSin = std::sin(delta);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        oscillatorCos[(size_t)i] = (SampleType)phaseCos;
+        oscillatorSin[(size_t)i] = (SampleType)phaseSin;
+
+        const double nextCos = phaseCos * rotationCos - phaseSin * rotationSin;
+        phaseSin = phaseSin * rotationCos + phaseCos * rotationSin;
+        phaseCos = nextCos;
+    }
+
+    const double gain = 1.5 - 0.5 * (phaseCos * phaseCos + phaseSin * phaseSin);
+    phaseCos *= gain;
+    phaseSin *= gain;
+
+    const int laneCount = (int)Lanes::size();
+    alignas(Lanes::SIMDRegisterSize) SampleType frame[Lanes::SIMDNumElements] = {};
+
+    for (int first = 0, groupIndex = 0; first < numChannels; first += laneCount, ++groupIndex)
+    {
+        auto& group = groups[(size_t)groupIndex];
+        const int count = juce::jmin(laneCount, numChannels - first);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int lane = 0; lane < count; ++lane)
+                frame[lane] = channels[first + lane][i];
+
+            const auto input = Lanes::fromRawArray(frame);
+            const auto inPhase = group.delayedA;
+            group.delayedA = processPath(group.pathA, pathACoefficients<SampleType>, input);
+            const auto quadrature = processPath(group.pathB, pathBCoefficients<SampleType>, input);
+
+            // Path B leads path A by 90 degrees, so this keeps the upper sideband for a positive shift
+            const auto output = inPhase * oscillatorCos[(size_t)i] + quadrature * oscillatorSin[(size_t)i];
+            output.copyToRawArray(frame);
+
+            for (int lane = 0; lane < count; ++lane)
+                channels[first + lane][i] = frame[lane];
+        }
+    }
+}
+
+template class FrequencyShifter<float>;
+template class FrequencyShifter<double>;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Zero-latency frequency shifter for the Spectral Shift control.
+//
+// A pair of 8th-order IIR allpass chains (four z^-2 sections each) splits the
+// signal into two outputs 90 degrees apart, within 0.6 degrees from 0.002 to
+// 0.99 of Nyquist. Mixing them with a quadrature oscillator moves every
+// partial by the same number of Hz (single sideband), with no lookahead.
+//
+// Channels are processed as SIMD lanes: each juce::dsp::SIMDRegister carries
+// one sample from each of up to Lanes::size() channels through the filters, and
+// the oscillator is shared by every lane. Full scale is +/- sampleRate / 8, the
+// same range as the STFT shifter.
+template <typename SampleType>
+class FrequencyShifter
+{
+public:
+    FrequencyShifter() = default;
+
+    void prepare(int maximumBlockSize, int numChannels);
+    void reset();
+
+    // Shifts every channel in place; shift is the -1..1 parameter value. A
+    // shift of zero leaves the signal untouched.
+    void process(SampleType* const* channels, int numChannels, int numSamples, float shift) noexcept;
+
+    // True once a non-zero shift has been processed, until the shift returns to zero
+    bool isActive() const noexcept { return active; }
+
+    static constexpr double maxShiftPerSample = juce::MathConstants<double>::twoPi / 8.0;   // radians, at shift = 1
+
+    // Ringing of the slowest allpass section (pole radius 0.99875) down to -120 dB
+    static constexpr int tailLengthSamples = 11050;
+
+private:
+    using Lanes = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int numSections = 4;
+
+    struct AllpassSection
+    {
+        Lanes x1, x2, y1, y2;
+    };
+
+    // One group of up to Lanes::size() channels
+    struct LaneGroup
+    {
+        AllpassSection pathA[numSections];
+        AllpassSection pathB[numSections];
+        Lanes delayedA;     // Path A carries an extra sample of delay
+    };
+
+    static Lanes processPath(AllpassSection* sections, const SampleType* coefficients, Lanes input) noexcept;
+
+    std::vector<LaneGroup> groups;
+
+    // Quadrature oscillator, rendered once per block and shared by every lane
+    std::vector<SampleType> oscillatorCos;
+    std::vector<SampleType> oscillatorSin;
+    double phaseCos = 1.0;
+    double phaseSin = 0.0;
+
+    bool active = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrequencyShifter)
+};
@@ -0,0 +1,78 @@
+#include "ModulationOscillator.h"
+
+void ModulationOscillator::prepare(double newSampleRate, int maximumBlockSize)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    output.assign((size_t)juce::jmax(1, maximumBlockSize), 0.0f);
+    reset();
+}
+
+double ModulationOscillator::getIncrement(double rateHz) const noexcept
+{
+    // Cycles per sample, kept below Nyquist
+    return juce::jlimit(0.0, 0.5, rateHz / sampleRate);
+}
+
+void ModulationOscillator::advance(int numSamples, double rateHz) noexcept
+{
+    setPhase(phase + getIncrement(rateHz) * (double)numSamples);
+}
+
+const float* ModulationOscillator::getNextBlock(int numSamples, double rateHz, Shape shape) noexcept
+{
+    jassert(numSamples <= (int)output.size());
+
+    const double increment = getIncrement(rateHz);
+    auto* data = output.data();
+
+    if (shape == Shape::sine)
+    {
+        const double angle = juce::MathConstants<double>::twoPi * phase;
+        const double step = juce::MathConstants<double>::twoPi * increment;
+        const double rotationCos = std::cos(step);
+        const double rotationSin = std::sin(step);
+        double c = std::cos(angle);
+        double s = std::sin(angle);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            data[i] = (float)s;
+
+            const double nextCos = c * rotationCos - s * rotationSin;
+            s = s * rotationCos + c * rotationSin;
+            c = nextCos;
+        }
+    }
+    else
+    {
+        // Each sample's phase comes from the block start, so there is no
+        // loop-carried state; the offsets make every shape start at zero
+        const float start = (float)phase;
+        const float step = (float)increment;
+
+        auto fraction = [start, step] (int i, float offset) noexcept
+        {
+            const float position = start + offset + step * (float)i;
+            return position - (float)(int)position;
+        };
+
+        if (shape == Shape::triangle)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = 1.0f - 4.0f * std::abs(fraction(i, 0.25f) - 0.5f);
+        }
+        else if (shape == Shape::saw)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = 2.0f * fraction(i, 0.5f) - 1.0f;
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = fraction(i, 0.0f) < 0.5f ? 1.0f : -1.0f;
+        }
+    }
+
+    setPhase(phase + increment * (double)numSamples);
+    return data;
+}
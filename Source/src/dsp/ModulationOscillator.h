@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// LFO for the Bit Modulation control.
+//
+// The phase is kept in cycles and advanced by rate / sampleRate, so a given
+// rate in Hz sounds the same at any sample rate. One oscillator is shared by
+// every channel and renders a whole block at a time: the sine with a rotation
+// recurrence in double, re-anchored from the phase at the start of each block
+// (two library calls per block, none per sample); the other shapes from a
+// phase ramp in a loop of plain float maths that vectorises.
+//
+// The phase runs with the sample clock whether or not the output is used;
+// call advance() for samples that are not rendered. setPhase() locks it to
+// the host's beat position when tempo sync is on.
+class ModulationOscillator
+{
+public:
+    enum class Shape
+    {
+        sine = 0,
+        triangle,
+        saw,
+        square
+    };
+
+    ModulationOscillator() = default;
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void reset() noexcept { phase = 0.0; }
+
+    // Values in [-1, 1] for the next numSamples, all shapes starting at zero
+    // and rising from phase 0. Valid until the next call.
+    const float* getNextBlock(int numSamples, double rateHz, Shape shape) noexcept;
+
+    void advance(int numSamples, double rateHz) noexcept;
+
+    // Phase in cycles; only the fractional part is used
+    void setPhase(double cycles) noexcept { phase = cycles - std::floor(cycles); }
+    double getPhase() const noexcept { return phase; }
+
+private:
+    double getIncrement(double rateHz) const noexcept;
+
+    std::vector<float> output;
+    double sampleRate = 44100.0;
+    double phase = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationOscillator)
+};
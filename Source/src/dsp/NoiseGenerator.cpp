@@ -0,0 +1,44 @@
+#include "NoiseGenerator.h"
+
+juce::uint32 NoiseGenerator::hash(juce::uint32 x) noexcept
+{
+    // 32-bit integer finaliser with low bias (Wellons' lowbias32)
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+void NoiseGenerator::prepare(int numChannels)
+{
+    keys.assign((size_t)juce::jmax(1, numChannels), 0);
+    updateKeys();
+    reset();
+}
+
+void NoiseGenerator::setSeed(juce::uint32 newSeed)
+{
+    seed = newSeed;
+    updateKeys();
+}
+
+void NoiseGenerator::updateKeys()
+{
+    for (size_t channel = 0; channel < keys.size(); ++channel)
+        keys[channel] = hash(seed ^ hash((juce::uint32)channel + 0x9e3779b9U));
+}
+
+void NoiseGenerator::fill(float* destination, int numSamples, int channel) const noexcept
+{
+    const juce::uint32 key = keys[(size_t)channel];
+
+    // The key enters both rounds, so no channel's stream is a shifted copy of
+    // another's. The top 24 bits convert to float exactly.
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const juce::uint32 x = hash(hash((position + (juce::uint32)i) ^ key) + key);
+        destination[i] = (float)(int)(x >> 8) * (1.0f / 8388608.0f) - 1.0f;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Counter-based noise for the crusher's jitter.
+//
+// Each value is a pure function of (seed, channel, sample position): two
+// keyed rounds of a 32-bit integer hash, with no state carried from one
+// sample to the next. A whole block is filled in one loop of integer maths
+// that vectorises, the result does not depend on the block size or on the
+// order channels are processed in, and it is bit-identical on every CPU.
+//
+// The position is shared by all channels and moves on with advance(), once
+// per processed or skipped chunk, so it always matches the sample clock since
+// the last reset(). It wraps after 2^32 samples (27 hours at 44.1 kHz).
+class NoiseGenerator
+{
+public:
+    NoiseGenerator() = default;
+
+    void prepare(int numChannels);
+
+    // Derives one stream key per channel; takes effect immediately
+    void setSeed(juce::uint32 newSeed);
+    juce::uint32 getSeed() const noexcept { return seed; }
+
+    // Back to the start of every stream
+    void reset() noexcept { position = 0; }
+
+    // Uniform noise in [-1, 1) for the next numSamples of a channel. Does not
+    // move the position, so every channel of a chunk reads the same span.
+    void fill(float* destination, int numSamples, int channel) const noexcept;
+
+    void advance(int numSamples) noexcept { position += (juce::uint32)numSamples; }
+
+private:
+    static juce::uint32 hash(juce::uint32 x) noexcept;
+    void updateKeys();
+
+    std::vector<juce::uint32> keys;
+    juce::uint32 seed = 0;
+    juce::uint32 position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NoiseGenerator)
+};
@@ -0,0 +1,63 @@
+#include "ParameterRamp.h"
+
+template <typename SampleType>
+void ParameterRamp<SampleType>::prepare(double sampleRate, double rampLengthSeconds, int maximumBlockSize, bool isMultiplicative)
+{
+    ramp.assign((size_t)juce::jmax(1, maximumBlockSize), SampleType(0));
+    rampLength = juce::jmax(1, (int)std::round(sampleRate * rampLengthSeconds));
+    multiplicative = isMultiplicative;
+    reset();
+}
+
+template <typename SampleType>
+const SampleType* ParameterRamp<SampleType>::getNextBlock(SampleType newTarget, int numSamples) noexcept
+{
+    jassert(numSamples <= (int)ramp.size());
+
+    if (needsSnap)
+    {
+        current = target = newTarget;
+        stepsRemaining = 0;
+        needsSnap = false;
+    }
+    else if (newTarget != target)
+    {
+        // Restart from wherever the previous ramp had got to
+        target = newTarget;
+        stepsRemaining = rampLength;
+        step = multiplicative ? std::pow(target / current, SampleType(1) / (SampleType)rampLength)
+                              : (target - current) / (SampleType)rampLength;
+    }
+
+    if (stepsRemaining == 0)
+        return nullptr;
+
+    auto* data = ramp.data();
+    const int rampSamples = juce::jmin(numSamples, stepsRemaining);
+
+    if (multiplicative)
+    {
+        for (int i = 0; i < rampSamples; ++i)
+            data[i] = (current *= step);
+    }
+    else
+    {
+        for (int i = 0; i < rampSamples; ++i)
+            data[i] = (current += step);
+    }
+
+    stepsRemaining -= rampSamples;
+
+    // Land exactly on the target and hold it for the rest of the block
+    if (stepsRemaining == 0)
+    {
+        current = target;
+        data[rampSamples - 1] = target;
+        juce::FloatVectorOperations::fill(data + rampSamples, target, numSamples - rampSamples);
+    }
+
+    return data;
+}
+
+template class ParameterRamp<float>;
+template class ParameterRamp<double>;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Block-rate parameter smoother.
+//
+// Instead of a per-sample getNextValue() call, the ramp for a whole block is
+// written once into a buffer the kernels read directly. A parameter that is
+// not moving stores nothing: getNextBlock() returns nullptr and the kernels
+// fall back to their scalar path with get(), so static parameters cost nothing.
+//
+// Multiplicative ramps move in equal ratios per sample, for values that are
+// perceived logarithmically; they need strictly positive values. Ramps are in
+// the engine's sample type so the kernels read them without conversion.
+template <typename SampleType>
+class ParameterRamp
+{
+public:
+    ParameterRamp() = default;
+
+    void prepare(double sampleRate, double rampLengthSeconds, int maximumBlockSize, bool isMultiplicative = false);
+
+    // The next block snaps to its target instead of ramping
+    void reset() noexcept { needsSnap = true; }
+
+    // Ramp values for the next numSamples, or nullptr if the value is static
+    const SampleType* getNextBlock(SampleType newTarget, int numSamples) noexcept;
+
+    // Current value; valid as the scalar whenever getNextBlock() returned nullptr
+    SampleType get() const noexcept { return current; }
+
+private:
+    std::vector<SampleType> ramp;
+    int rampLength = 1;
+    int stepsRemaining = 0;
+
+    SampleType current = 0;
+    SampleType target = 0;
+    SampleType step = 0;
+
+    bool multiplicative = false;
+    bool needsSnap = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterRamp)
+};
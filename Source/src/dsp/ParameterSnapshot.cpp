@@ -0,0 +1,139 @@
+#include "ParameterSnapshot.h"
+
+namespace
+{
+    const char* const parameterIDs[] = { "drive", "mix", "saturation", "midside", "mspairs", "threshold", "attack", "release",
+                                         "bitcrush", "bitmodulation", "bitmodrate", "bitmodshape", "bitmodsync",
+                                         "bitmodnote", "downsample", "jitter", "spectralshift",
+                                         "oversampling", "osfilter", "shapermode", "spectralmode",
+                                         "deterministicjitter" };
+
+    // One-pole coefficient for a time constant in milliseconds
+    float getTimeConstantCoeff(double sampleRate, float milliseconds)
+    {
+        return static_cast<float>(std::exp(-1.0 / (sampleRate * milliseconds * 0.001f)));
+    }
+}
+
+ParameterSnapshot::ParameterSnapshot(juce::AudioProcessorValueTreeState& state)
+    : valueTreeState(state)
+{
+    drive = valueTreeState.getRawParameterValue("drive");
+    mix = valueTreeState.getRawParameterValue("mix");
+    saturation = valueTreeState.getRawParameterValue("saturation");
+    midSide = valueTreeState.getRawParameterValue("midside");
+    midSidePairs = valueTreeState.getRawParameterValue("mspairs");
+    threshold = valueTreeState.getRawParameterValue("threshold");
+    attack = valueTreeState.getRawParameterValue("attack");
+    release = valueTreeState.getRawParameterValue("release");
+    bitCrush = valueTreeState.getRawParameterValue("bitcrush");
+    bitModulation = valueTreeState.getRawParameterValue("bitmodulation");
+    bitModulationRate = valueTreeState.getRawParameterValue("bitmodrate");
+    bitModulationShape = valueTreeState.getRawParameterValue("bitmodshape");
+    bitModulationSync = valueTreeState.getRawParameterValue("bitmodsync");
+    bitModulationNote = valueTreeState.getRawParameterValue("bitmodnote");
+    downsample = valueTreeState.getRawParameterValue("downsample");
+    jitter = valueTreeState.getRawParameterValue("jitter");
+    spectralShift = valueTreeState.getRawParameterValue("spectralshift");
+    oversampling = valueTreeState.getRawParameterValue("oversampling");
+    oversamplingFilter = valueTreeState.getRawParameterValue("osfilter");
+    shaperMode = valueTreeState.getRawParameterValue("shapermode");
+    spectralMode = valueTreeState.getRawParameterValue("spectralmode");
+    deterministicJitter = valueTreeState.getRawParameterValue("deterministicjitter");
+
+    for (auto* id : parameterIDs)
+    {
+        jassert(valueTreeState.getRawParameterValue(id) != nullptr);
+        valueTreeState.addParameterListener(id, this);
+    }
+}
+
+ParameterSnapshot::~ParameterSnapshot()
+{
+    for (auto* id : parameterIDs)
+        valueTreeState.removeParameterListener(id, this);
+}
+
+void ParameterSnapshot::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    dirty = true;
+}
+
+void ParameterSnapshot::setJitterSeed(juce::uint32 seed) noexcept
+{
+    jitterSeed = seed;
+    dirty = true;
+}
+
+void ParameterSnapshot::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    // The atomic has already been written when this is called, so the next
+    // update() is guaranteed to see the new value
+    juce::ignoreUnused(parameterID, newValue);
+    dirty = true;
+}
+
+const DistortionEngineBase::Parameters& ParameterSnapshot::update() noexcept
+{
+    // Cleared before reading, so a change that lands mid-update is picked up next block
+    if (! dirty.exchange(false))
+        return parameters;
+
+    parameters.drive = drive->load();
+    parameters.mix = mix->load();
+    parameters.saturation = saturation->load();
+    parameters.midSide = midSide->load();
+    parameters.midSidePairs = static_cast<DistortionEngineBase::MidSidePairs>((int)midSidePairs->load());
+    parameters.bitModulation = bitModulation->load();
+    parameters.modulationRate = bitModulationRate->load();
+    parameters.modulationShape = static_cast<ModulationOscillator::Shape>((int)bitModulationShape->load());
+    parameters.modulationSync = bitModulationSync->load() >= 0.5f;
+
+    // Note choices run 1/1, 1/2 ... 1/64
+    parameters.modulationBeats = 4.0 / (double)(1 << juce::jlimit(0, 6, (int)bitModulationNote->load()));
+    parameters.spectralShift = spectralShift->load();
+    parameters.downsample = downsample->load();
+    parameters.jitter = jitter->load();
+    parameters.shaperMode = static_cast<DistortionEngineBase::ShaperMode>((int)shaperMode->load());
+
+    oversamplingOrder = (int)oversampling->load();
+    linearPhase = (int)oversamplingFilter->load() == 1;
+    selectedSpectralMode = static_cast<DistortionEngineBase::SpectralMode>((int)spectralMode->load());
+    deterministicJitterOn = deterministicJitter->load() >= 0.5f;
+    currentJitterSeed = jitterSeed.load();
+
+    // Derived values
+    const bool rateChanged = sampleRate != derivedSampleRate;
+    derivedSampleRate = sampleRate;
+
+    const float newAttack = attack->load();
+    if (rateChanged || newAttack != lastAttack)
+    {
+        parameters.attackCoeff = getTimeConstantCoeff(sampleRate, newAttack);
+        lastAttack = newAttack;
+    }
+
+    const float newRelease = release->load();
+    if (rateChanged || newRelease != lastRelease)
+    {
+        parameters.releaseCoeff = getTimeConstantCoeff(sampleRate, newRelease);
+        lastRelease = newRelease;
+    }
+
+    const float newThreshold = threshold->load();
+    if (rateChanged || newThreshold != lastThreshold)
+    {
+        parameters.threshold = juce::Decibels::decibelsToGain(newThreshold);
+        lastThreshold = newThreshold;
+    }
+
+    const float newBitCrush = bitCrush->load();
+    if (rateChanged || newBitCrush != lastBitCrush)
+    {
+        parameters.crusherLevels = std::pow(2.0f, newBitCrush) - 1.0f;
+        lastBitCrush = newBitCrush;
+    }
+
+    return parameters;
+}
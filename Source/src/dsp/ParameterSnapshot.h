@@ -0,0 +1,85 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DistortionEngine.h"
+
+// Audio-thread view of the plugin parameters.
+//
+// The raw atomic value of every parameter is looked up once, at construction,
+// instead of by string ID on every block. A listener raises a dirty flag when
+// any of them moves; update() only reloads the values when the flag is set,
+// and the derived values (gate time constants, linear threshold, quantizer
+// levels) are only recomputed when their own inputs or the sample rate have
+// changed, so a block with no automation costs a single atomic exchange.
+class ParameterSnapshot : private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    explicit ParameterSnapshot(juce::AudioProcessorValueTreeState& state);
+    ~ParameterSnapshot() override;
+
+    // Sets the rate the gate time constants are derived for and forces a full refresh
+    void prepare(double sampleRate);
+
+    // Called at the top of each block; cheap when nothing has changed
+    const DistortionEngineBase::Parameters& update() noexcept;
+
+    const DistortionEngineBase::Parameters& getParameters() const noexcept { return parameters; }
+    int getOversamplingOrder() const noexcept { return oversamplingOrder; }
+    bool isLinearPhaseOversampling() const noexcept { return linearPhase; }
+    DistortionEngineBase::SpectralMode getSpectralMode() const noexcept { return selectedSpectralMode; }
+    bool isDeterministicJitter() const noexcept { return deterministicJitterOn; }
+    juce::uint32 getJitterSeed() const noexcept { return currentJitterSeed; }
+
+    // The project's jitter seed is state rather than a parameter; setting it
+    // from any thread marks the snapshot dirty like a parameter change
+    void setJitterSeed(juce::uint32 seed) noexcept;
+
+private:
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    juce::AudioProcessorValueTreeState& valueTreeState;
+
+    std::atomic<float>* drive = nullptr;
+    std::atomic<float>* mix = nullptr;
+    std::atomic<float>* saturation = nullptr;
+    std::atomic<float>* midSide = nullptr;
+    std::atomic<float>* midSidePairs = nullptr;
+    std::atomic<float>* threshold = nullptr;
+    std::atomic<float>* attack = nullptr;
+    std::atomic<float>* release = nullptr;
+    std::atomic<float>* bitCrush = nullptr;
+    std::atomic<float>* bitModulation = nullptr;
+    std::atomic<float>* bitModulationRate = nullptr;
+    std::atomic<float>* bitModulationShape = nullptr;
+    std::atomic<float>* bitModulationSync = nullptr;
+    std::atomic<float>* bitModulationNote = nullptr;
+    std::atomic<float>* downsample = nullptr;
+    std::atomic<float>* jitter = nullptr;
+    std::atomic<float>* spectralShift = nullptr;
+    std::atomic<float>* oversampling = nullptr;
+    std::atomic<float>* oversamplingFilter = nullptr;
+    std::atomic<float>* shaperMode = nullptr;
+    std::atomic<float>* spectralMode = nullptr;
+    std::atomic<float>* deterministicJitter = nullptr;
+
+    std::atomic<juce::uint32> jitterSeed { 0 };
+    std::atomic<bool> dirty { true };
+
+    double sampleRate = 44100.0;
+
+    // Inputs of the derived values, as they were when last computed
+    double derivedSampleRate = 0.0;
+    float lastAttack = 0.0f;
+    float lastRelease = 0.0f;
+    float lastThreshold = 0.0f;
+    float lastBitCrush = 0.0f;
+
+    DistortionEngineBase::Parameters parameters;
+    int oversamplingOrder = 0;
+    bool linearPhase = false;
+    DistortionEngineBase::SpectralMode selectedSpectralMode = DistortionEngineBase::SpectralMode::frequencyShifter;
+    bool deterministicJitterOn = false;
+    juce::uint32 currentJitterSeed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSnapshot)
+};
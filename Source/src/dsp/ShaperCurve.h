@@ -0,0 +1,53 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "VectorKernelFunctions.h"
+
+// The saturation transfer curve, applied to an already driven sample.
+//
+// Coefficients that only depend on the saturation amount are hoisted into the
+// constructor, so a block loop builds one ShaperCurve and calls it per sample,
+// and the vector kernels take them as plain ShaperCoefficients. Templated so
+// the ADAA and lookup-table builders can evaluate it in double.
+template <typename SampleType>
+struct ShaperCurve : ShaperCoefficients<SampleType>
+{
+    using Coefficients = ShaperCoefficients<SampleType>;
+    using Coefficients::saturation, Coefficients::clipGain, Coefficients::shapeGain, Coefficients::shapeKnee,
+          Coefficients::dryGain, Coefficients::wetGain, Coefficients::downScale, Coefficients::upScale;
+
+    explicit ShaperCurve(SampleType saturationAmount) noexcept
+        : Coefficients { saturationAmount,
+                         SampleType(1) + saturationAmount * SampleType(4),
+                         SampleType(1) + saturationAmount * SampleType(0.5),
+                         saturationAmount * SampleType(3),
+                         SampleType(1) - saturationAmount,
+                         saturationAmount * Coefficients::upScale }
+    {
+    }
+
+    SampleType operator()(SampleType driven) const noexcept
+    {
+        constexpr auto twoPi = juce::MathConstants<SampleType>::twoPi;
+        constexpr auto threePi = juce::MathConstants<SampleType>::pi * SampleType(3);
+        constexpr auto fourPi = juce::MathConstants<SampleType>::twoPi * SampleType(2);
+
+        const SampleType scaled = driven * downScale;
+        const SampleType scaled2 = scaled * scaled;
+        const SampleType scaled3 = scaled2 * scaled;
+
+        // Soft clipper plus cubic and quintic terms
+        const SampleType clipped = std::tanh(scaled * clipGain) + SampleType(0.3) * scaled3
+                                 - SampleType(0.1) * scaled3 * scaled2;
+
+        // Harmonic generation
+        const SampleType harmonics = (std::sin(driven * twoPi) * SampleType(0.12)
+                                    + std::sin(driven * threePi) * SampleType(0.07)
+                                    + std::sin(driven * fourPi) * SampleType(0.03)) * saturation;
+
+        const SampleType shaped = clipped + harmonics;
+        const SampleType distorted = (shaped * shapeGain) / (SampleType(1) + std::abs(shaped * shapeKnee));
+
+        return dryGain * driven + wetGain * distorted;
+    }
+};
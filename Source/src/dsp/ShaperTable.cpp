@@ -0,0 +1,67 @@
+#include "ShaperTable.h"
+#include "ShaperCurve.h"
+
+namespace
+{
+    // Samples looked up per kernel call; the inputs are kept for the exact fallback
+    constexpr int lookupChunkSize = 64;
+}
+
+ShaperTable::ShaperTable()
+{
+    table.resize((size_t)(numSaturationSlices * pointsPerSlice));
+
+    const double step = 1.0 / (double)pointsPerUnit;
+
+    for (int slice = 0; slice < numSaturationSlices; ++slice)
+    {
+        const ShaperCurve<double> curve((double)slice / (double)(numSaturationSlices - 1));
+        auto* values = table.data() + slice * pointsPerSlice;
+
+        // values[1] sits at the origin
+        for (int i = 1; i < pointsPerSlice; ++i)
+            values[i] = (float)curve((i - 1) * step);
+
+        // The curve's second derivative jumps at the origin, so the guard point
+        // below zero is extrapolated from the positive side instead of mirrored
+        values[0] = 3.0f * values[1] - 3.0f * values[2] + values[3];
+    }
+}
+
+template <typename SampleType>
+void ShaperTable::process(SampleType* data, int numSamples, float saturation,
+                          const VectorKernels::Table<SampleType>& kernels) const noexcept
+{
+    // Both slices and the blend weight are fixed for the block
+    const float slicePosition = juce::jlimit(0.0f, 1.0f, saturation) * (float)(numSaturationSlices - 1);
+    const int lowerSlice = juce::jmin((int)slicePosition, numSaturationSlices - 2);
+
+    VectorKernels::TableSlices slices;
+    slices.lower = table.data() + lowerSlice * pointsPerSlice;
+    slices.upper = slices.lower + pointsPerSlice;
+    slices.weight = slicePosition - (float)lowerSlice;
+    slices.pointsPerUnit = (float)pointsPerUnit;
+    slices.range = tableRange;
+
+    SampleType driven[lookupChunkSize];
+
+    for (int start = 0; start < numSamples; start += lookupChunkSize)
+    {
+        const int count = juce::jmin(lookupChunkSize, numSamples - start);
+        SampleType* chunk = data + start;
+        std::copy(chunk, chunk + count, driven);
+
+        // Rare out-of-range samples are evaluated exactly
+        if (kernels.shapeTable(driven, chunk, count, slices))
+        {
+            const ShaperCurve<SampleType> curve((SampleType)saturation);
+
+            for (int i = 0; i < count; ++i)
+                if (std::abs(driven[i]) >= (SampleType)tableRange)
+                    chunk[i] = curve(driven[i]);
+        }
+    }
+}
+
+template void ShaperTable::process<float>(float*, int, float, const VectorKernels::Table<float>&) const noexcept;
+template void ShaperTable::process<double>(double*, int, float, const VectorKernels::Table<double>&) const noexcept;
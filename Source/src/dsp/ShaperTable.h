@@ -0,0 +1,52 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "VectorKernels.h"
+
+// Lookup-table evaluator for the saturation curve, shared by every processor
+// instance in the process.
+//
+// Hold it through a juce::SharedResourcePointer<ShaperTable>: the table is
+// built (in double, stored as float) when the first holder is created and
+// freed when the last one goes away, so hundreds of instances share a single
+// copy. The table is read-only after construction and safe to use from any
+// number of audio threads.
+//
+// Layout: one slice per saturation step, each slice sampling the curve over
+// the positive driven input range (the curve is odd, so lookups use |x| and
+// restore the sign). Lookups use Catmull-Rom interpolation along the input and
+// linear interpolation between the two nearest saturation slices. Driven
+// samples beyond tableRange fall back to the exact curve. Total size is about
+// 530 KB for the whole process.
+//
+// The lookup itself is the shapeTable kernel of VectorKernels, so the
+// position maths and the blend run vectorised in the SSE2, AVX2 and AVX-512
+// builds; the table reads become packed gathers where the compiler tunes for
+// them and element loads otherwise. Benchmarks/ShaperTableBenchmark measures the error
+// against ShaperCurve over the drive x saturation grid and times the table
+// against the exact curve for every kernel set; it fails if the error goes
+// past maxError.
+class ShaperTable
+{
+public:
+    ShaperTable();
+
+    // data holds driven samples on entry and shaped samples on exit. The table
+    // is float; double data is interpolated in double from it.
+    template <typename SampleType>
+    void process(SampleType* data, int numSamples, float saturation, const VectorKernels::Table<SampleType>& kernels) const noexcept;
+
+    static constexpr int numSaturationSlices = 65;
+    static constexpr int pointsPerUnit = 64;
+    static constexpr float tableRange = 32.0f;
+
+    // Largest absolute difference from ShaperCurve over the parameter ranges
+    static constexpr float maxError = 3.0e-3f;
+
+private:
+    static constexpr int pointsPerSlice = (int)tableRange * pointsPerUnit + 4;   // plus Catmull-Rom guard points
+
+    std::vector<float> table;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ShaperTable)
+};
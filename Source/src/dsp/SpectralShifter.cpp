@@ -0,0 +1,145 @@
+#include "SpectralShifter.h"
+
+SpectralShifter::SpectralShifter()
+    : forwardFFT(fftOrder),
+      inverseFFT(fftOrder),
+      window((size_t)fftSize, juce::dsp::WindowingFunction<float>::hann)
+{
+    fftData.resize((size_t)(2 * fftSize));
+
+    // Analysis and synthesis both use the Hann window. Dividing the synthesis
+    // window by the overlapped sum of squares at each position within the hop
+    // makes an unshifted frame reconstruct the input exactly.
+    std::vector<float> analysis((size_t)fftSize, 1.0f);
+    window.multiplyWithWindowingTable(analysis.data(), (size_t)fftSize);
+
+    synthesisWindow.resize((size_t)fftSize);
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        double overlapSum = 0.0;
+
+        for (int j = i % hopSize; j < fftSize; j += hopSize)
+            overlapSum += (double)analysis[(size_t)j] * (double)analysis[(size_t)j];
+
+        synthesisWindow[(size_t)i] = (float)((double)analysis[(size_t)i] / overlapSum);
+    }
+}
+
+void SpectralShifter::prepare(int numChannels)
+{
+    const int channels = juce::jmax(1, numChannels);
+
+    fftBuffer.setSize(channels, fftSize, false, true, false);
+    overlapBuffer.setSize(channels, fftSize, false, true, false);
+
+    ringPositions.assign((size_t)channels, 0);
+    hopCounters.assign((size_t)channels, 0);
+    frameCounters.assign((size_t)channels, 0);
+
+    reset();
+}
+
+void SpectralShifter::reset()
+{
+    fftBuffer.clear();
+    overlapBuffer.clear();
+
+    std::fill(ringPositions.begin(), ringPositions.end(), 0);
+    std::fill(hopCounters.begin(), hopCounters.end(), 0);
+    std::fill(frameCounters.begin(), frameCounters.end(), 0u);
+}
+
+template <typename SampleType>
+void SpectralShifter::process(SampleType* data, int numSamples, int channel, float shift) noexcept
+{
+    jassert(channel < fftBuffer.getNumChannels());
+
+    const int shiftBins = juce::roundToInt(juce::jlimit(-1.0f, 1.0f, shift) * (float)maxShiftBins);
+
+    auto* input = fftBuffer.getWritePointer(channel);
+    auto* output = overlapBuffer.getWritePointer(channel);
+    int position = ringPositions[(size_t)channel];
+    int hop = hopCounters[(size_t)channel];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        input[position] = (float)data[i];
+        data[i] = (SampleType)output[position];
+        output[position] = 0.0f;
+
+        position = (position + 1) & (fftSize - 1);
+
+        if (++hop == hopSize)
+        {
+            hop = 0;
+            ringPositions[(size_t)channel] = position;
+            processFrame(channel, shiftBins);
+        }
+    }
+
+    ringPositions[(size_t)channel] = position;
+    hopCounters[(size_t)channel] = hop;
+}
+
+template void SpectralShifter::process<float>(float*, int, int, float) noexcept;
+template void SpectralShifter::process<double>(double*, int, int, float) noexcept;
+
+void SpectralShifter::processFrame(int channel, int shiftBins) noexcept
+{
+    const auto* input = fftBuffer.getReadPointer(channel);
+    auto* output = overlapBuffer.getWritePointer(channel);
+    const int position = ringPositions[(size_t)channel];
+    auto* frame = fftData.data();
+
+    // Unroll the ring, oldest sample first
+    const int tail = fftSize - position;
+    std::copy(input + position, input + fftSize, frame);
+    std::copy(input, input + position, frame + tail);
+
+    window.multiplyWithWindowingTable(frame, (size_t)fftSize);
+
+    if (shiftBins != 0)
+    {
+        std::fill(frame + fftSize, frame + 2 * fftSize, 0.0f);
+        forwardFFT.performRealOnlyForwardTransform(frame, true);
+
+        // Moving a partial up k bins should advance its phase by 2*pi*k*hop/fftSize
+        // = k*pi/2 per frame, i.e. by j^(k * frame)
+        static const std::complex<float> quarterTurns[] = { { 1.0f, 0.0f }, { 0.0f, 1.0f },
+                                                            { -1.0f, 0.0f }, { 0.0f, -1.0f } };
+        const auto frameIndex = frameCounters[(size_t)channel]++;
+        const auto rotation = quarterTurns[((juce::uint32)shiftBins * frameIndex) & 3u];
+
+        auto* bins = reinterpret_cast<std::complex<float>*>(frame);
+        const int numBins = fftSize / 2 + 1;
+
+        if (shiftBins > 0)
+        {
+            for (int bin = numBins - 1; bin >= shiftBins; --bin)
+                bins[bin] = bins[bin - shiftBins] * rotation;
+
+            std::fill(bins, bins + shiftBins, std::complex<float>());
+        }
+        else
+        {
+            for (int bin = 0; bin < numBins + shiftBins; ++bin)
+                bins[bin] = bins[bin - shiftBins] * rotation;
+
+            std::fill(bins + numBins + shiftBins, bins + numBins, std::complex<float>());
+        }
+
+        // DC and Nyquist must stay real
+        bins[0] = { bins[0].real(), 0.0f };
+        bins[numBins - 1] = { bins[numBins - 1].real(), 0.0f };
+
+        inverseFFT.performRealOnlyInverseTransform(frame);
+    }
+
+    // Overlap-add into the output ring, starting at the next sample to be read
+    for (int i = 0; i < tail; ++i)
+        output[position + i] += frame[i] * synthesisWindow[(size_t)i];
+
+    for (int i = tail; i < fftSize; ++i)
+        output[i - tail] += frame[i] * synthesisWindow[(size_t)i];
+}
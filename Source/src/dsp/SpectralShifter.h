@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Overlap-add STFT bin shifter for the Spectral Shift control.
+//
+// Each channel is framed at a fixed hop (fftSize / 4) that does not depend on
+// the host block size, windowed with a Hann window, shifted by a whole number
+// of bins and resynthesised. The per-frame phase correction for a k-bin shift
+// at this hop is a power of j, so shifted partials stay phase-continuous
+// across frames without any trigonometry. A shift of zero bins skips the FFTs
+// but keeps the same latency.
+//
+// All frame and overlap buffers are allocated in prepare(). Latency is a full
+// frame (fftSize samples) at any block size; the cost is one forward and one
+// inverse FFT per hop per channel. juce::dsp::FFT is single precision, so
+// double data is framed and resynthesised in float.
+class SpectralShifter
+{
+public:
+    static constexpr int fftOrder = 10;
+    static constexpr int fftSize = 1 << fftOrder;   // 2^10 = 1024
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr int maxShiftBins = fftSize / 8; // Full-scale shift, about +/-6 kHz at 48 kHz
+
+    SpectralShifter();
+
+    void prepare(int numChannels);
+    void reset();
+
+    // Shifts data in place; shift is the -1..1 parameter value
+    template <typename SampleType>
+    void process(SampleType* data, int numSamples, int channel, float shift) noexcept;
+
+    static constexpr int getLatencyInSamples() noexcept { return fftSize; }
+
+private:
+    void processFrame(int channel, int shiftBins) noexcept;
+
+    juce::dsp::FFT forwardFFT;
+    juce::dsp::FFT inverseFFT;
+    juce::dsp::WindowingFunction<float> window;
+
+    juce::AudioBuffer<float> fftBuffer;         // Input history, one ring of fftSize per channel
+    juce::AudioBuffer<float> overlapBuffer;     // Output accumulator, same layout
+    std::vector<float> fftData;                 // Interleaved complex frame, 2 * fftSize
+    std::vector<float> synthesisWindow;         // Hann window scaled so the overlapped windows sum to one
+
+    std::vector<int> ringPositions;
+    std::vector<int> hopCounters;
+    std::vector<juce::uint32> frameCounters;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralShifter)
+};
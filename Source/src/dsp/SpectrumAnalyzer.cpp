@@ -0,0 +1,147 @@
+#include "SpectrumAnalyzer.h"
+
+SpectrumAnalyzer::SpectrumAnalyzer(AnalysisFifo& source)
+    : juce::Thread("Spectrum Analyzer"),
+      fifo(source),
+      fft(fftOrder),
+      window((size_t)fftSize, juce::dsp::WindowingFunction<float>::hann, false)
+{
+    history.resize((size_t)historySize, 0.0f);
+    fftData.resize((size_t)(2 * fftSize), 0.0f);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stop();
+}
+
+void SpectrumAnalyzer::setSampleRate(double newSampleRate) noexcept
+{
+    if (newSampleRate > 0.0)
+        pendingSampleRate.store(newSampleRate);
+}
+
+void SpectrumAnalyzer::start()
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+void SpectrumAnalyzer::stop()
+{
+    stopThread(1000);
+}
+
+const SpectrumAnalyzer::Frame& SpectrumAnalyzer::getLatestFrame() noexcept
+{
+    frames.acquire();
+    return frames.getReadBuffer();
+}
+
+void SpectrumAnalyzer::run()
+{
+    while (! threadShouldExit())
+    {
+        const double newSampleRate = pendingSampleRate.load();
+
+        if (newSampleRate != sampleRate)
+            updateBandLayout(newSampleRate);
+
+        // The history slides along the stream; anything older than one frame
+        // plus the hops still to analyse is dropped
+        const int received = fifo.readLatest(history.data(), historySize);
+        pendingSamples = juce::jmin(pendingSamples + received, historySize - fftSize + hopSize);
+
+        const float secondsPerHop = (float)(hopSize / sampleRate);
+        bool changed = false;
+
+        while (pendingSamples >= hopSize)
+        {
+            const int frameEnd = historySize - pendingSamples + hopSize;
+            changed = analyseFrame(history.data() + frameEnd - fftSize, secondsPerHop) || changed;
+            pendingSamples -= hopSize;
+        }
+
+        if (changed)
+            publishFrame();
+
+        // About one hop; the audio thread never signals, so this just polls
+        wait(juce::jmax(1, (int)(secondsPerHop * 1000.0f)));
+    }
+}
+
+void SpectrumAnalyzer::updateBandLayout(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    const float binsPerHz = (float)(fftSize / sampleRate);
+    const float topFrequency = juce::jmin(maxFrequency, (float)(sampleRate * 0.5));
+    const int lastBin = fftSize / 2;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const float low = minFrequency * std::pow(topFrequency / minFrequency, (float)band / (float)numBands);
+        const float high = minFrequency * std::pow(topFrequency / minFrequency, (float)(band + 1) / (float)numBands);
+
+        // Low bands narrower than a bin share their nearest one
+        const int start = juce::jlimit(1, lastBin, (int)std::round(low * binsPerHz));
+        const int end = juce::jlimit(start + 1, lastBin + 1, (int)std::round(high * binsPerHz));
+
+        bandStart[(size_t)band] = start;
+        bandEnd[(size_t)band] = end;
+    }
+}
+
+bool SpectrumAnalyzer::analyseFrame(const float* input, float secondsPerHop) noexcept
+{
+    const auto previousLevels = levels;
+    const auto previousPeaks = peaks;
+
+    std::copy(input, input + fftSize, fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    window.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // A full-scale sine peaks at fftSize / 4 through the Hann window
+    constexpr float magnitudeScale = 4.0f / (float)fftSize;
+    const float release = releaseDbPerSecond * secondsPerHop / -floorDb;
+
+    for (size_t band = 0; band < (size_t)numBands; ++band)
+    {
+        float magnitude = 0.0f;
+
+        for (int bin = bandStart[band]; bin < bandEnd[band]; ++bin)
+            magnitude = juce::jmax(magnitude, fftData[(size_t)bin]);
+
+        const float db = juce::Decibels::gainToDecibels(magnitude * magnitudeScale, floorDb);
+        const float level = juce::jlimit(0.0f, 1.0f, 1.0f - db / floorDb);
+
+        levels[band] = juce::jmax(level, levels[band] - release);
+
+        if (levels[band] >= peaks[band])
+        {
+            peaks[band] = levels[band];
+            peakHoldRemaining[band] = peakHoldSeconds;
+        }
+        else if (peakHoldRemaining[band] > 0.0f)
+        {
+            peakHoldRemaining[band] -= secondsPerHop;
+        }
+        else
+        {
+            peaks[band] = juce::jmax(levels[band], peaks[band] - release);
+        }
+    }
+
+    return levels != previousLevels || peaks != previousPeaks;
+}
+
+void SpectrumAnalyzer::publishFrame() noexcept
+{
+    auto& frame = frames.getWriteBuffer();
+    frame.levels = levels;
+    frame.peaks = peaks;
+    frame.frameNumber = ++framesAnalysed;
+
+    frames.publish();
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalysisFifo.h"
+#include "TripleBuffer.h"
+
+// Background spectrum analysis for the visualiser.
+//
+// A worker thread drains the processor's AnalysisFifo, runs Hann-windowed
+// FFTs every hopSize samples (75% overlap) and folds the bins into numBands
+// log-spaced bands between minFrequency and maxFrequency. Each band has fast
+// attack, a fixed release in dB per second and a peak marker that holds for
+// peakHoldSeconds before falling at the same rate. Levels are normalised so
+// 0 is floorDb and 1 is full scale.
+//
+// Finished frames are published through a lock-free TripleBuffer, so neither
+// side ever waits and the reader always gets a complete frame without
+// copying it. A frame is only published when some band has moved, so
+// silence settles into no new frames at all.
+//
+// The worker is the AnalysisFifo's only reader. It runs only while started,
+// which the editor does while it is open, so the analysis costs nothing on
+// the audio or message threads and nothing at all without a GUI.
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;   // 2^11 = 2048
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr int numBands = 64;
+
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float floorDb = -90.0f;
+    static constexpr float releaseDbPerSecond = 60.0f;
+    static constexpr float peakHoldSeconds = 0.8f;
+
+    struct Frame
+    {
+        std::array<float, numBands> levels {};
+        std::array<float, numBands> peaks {};
+        juce::uint32 frameNumber = 0;    // 0 until the first analysis
+    };
+
+    explicit SpectrumAnalyzer(AnalysisFifo& source);
+    ~SpectrumAnalyzer() override;
+
+    // Any thread; the worker picks the new band layout up on its next pass
+    void setSampleRate(double newSampleRate) noexcept;
+
+    // Message thread
+    void start();
+    void stop();
+
+    // Reader: the newest complete frame. Stays valid and unchanged until the
+    // next call; only one thread may read.
+    const Frame& getLatestFrame() noexcept;
+
+private:
+    void run() override;
+
+    void updateBandLayout(double sampleRate);
+    bool analyseFrame(const float* input, float secondsPerHop) noexcept;
+    void publishFrame() noexcept;
+
+    AnalysisFifo& fifo;
+    std::atomic<double> pendingSampleRate { 44100.0 };
+    double sampleRate = 0.0;
+
+    juce::dsp::FFT fft;
+    juce::dsp::WindowingFunction<float> window;
+
+    // Input history: one frame plus the most the worker analyses per pass
+    static constexpr int historySize = fftSize * 2;
+    std::vector<float> history;
+    std::vector<float> fftData;      // 2 * fftSize for the real-only transform
+    int pendingSamples = 0;          // Received but not yet covered by a hop
+
+    // First and one-past-last bin of each band; every band has at least one bin
+    std::array<int, numBands> bandStart {};
+    std::array<int, numBands> bandEnd {};
+
+    // Worker's running state, copied into a frame when it is published
+    std::array<float, numBands> levels {};
+    std::array<float, numBands> peaks {};
+    std::array<float, numBands> peakHoldRemaining {};
+
+    TripleBuffer<Frame> frames;
+    juce::uint32 framesAnalysed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Lock-free hand-over of whole objects from one writer thread to one reader.
+//
+// The writer fills its own buffer and swaps it with the shared one; the
+// reader swaps the shared one with its own only when it holds something
+// newer. Neither side ever waits or copies, and each owns its buffer outright
+// between swaps. A buffer handed back to the writer holds an older value, so
+// the writer must overwrite all of it.
+template <typename Type>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Writer
+    Type& getWriteBuffer() noexcept { return buffers[(size_t)writeIndex]; }
+
+    void publish() noexcept
+    {
+        writeIndex = sharedIndex.exchange(writeIndex | newValueFlag, std::memory_order_acq_rel) & ~newValueFlag;
+    }
+
+    // Reader: picks up the newest published value, if any, and returns
+    // whether it did. The read buffer stays unchanged until the next call.
+    bool acquire() noexcept
+    {
+        if ((sharedIndex.load(std::memory_order_relaxed) & newValueFlag) == 0)
+            return false;
+
+        readIndex = sharedIndex.exchange(readIndex, std::memory_order_acq_rel) & ~newValueFlag;
+        return true;
+    }
+
+    const Type& getReadBuffer() const noexcept { return buffers[(size_t)readIndex]; }
+
+private:
+    // Set in sharedIndex while the reader has not picked the shared buffer up
+    static constexpr int newValueFlag = 4;
+
+    std::array<Type, 3> buffers {};
+    std::atomic<int> sharedIndex { 1 };
+    int writeIndex = 0;
+    int readIndex = 2;
+
+    JUCE_DECLARE_NON_COPYABLE(TripleBuffer)
+};
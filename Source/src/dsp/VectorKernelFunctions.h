@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+// The plain types and function tables shared by VectorKernels and the
+// per-instruction-set translation units. MSVC applies those units' wider
+// target flags to the whole file, so they include only this header and
+// <cstring>, and this header only <cstdint>: inline JUCE or ShaperCurve code
+// pulled in there would be emitted with the wider encodings, and the linker
+// could keep that copy for code that runs on older CPUs.
+
+// JUCE_INTEL, for the units that cannot see JUCE's own
+#if defined (__x86_64__) || defined (__i386__) || defined (_M_X64) || defined (_M_IX86)
+ #define ANTSDISTSAT_KERNELS_INTEL 1
+#else
+ #define ANTSDISTSAT_KERNELS_INTEL 0
+#endif
+
+// ShaperCurve's coefficients, fixed for a block
+template <typename SampleType>
+struct ShaperCoefficients
+{
+    SampleType saturation, clipGain, shapeGain, shapeKnee, dryGain, wetGain;
+
+    // The original curve scaled the driven sample by 0.5^4 before the clipper
+    // and by 2^4 afterwards; both are exact powers of two
+    static constexpr SampleType downScale = SampleType(0.0625);
+    static constexpr SampleType upScale = SampleType(16);
+};
+
+// Two neighbouring saturation slices of a ShaperTable and the weight between
+// them, fixed for a block
+struct TableSlices
+{
+    const float* lower = nullptr;
+    const float* upper = nullptr;
+    float weight = 0.0f;            // Towards upper
+    float pointsPerUnit = 0.0f;
+    float range = 0.0f;             // |driven| covered by the slices; lookups clamp to it
+};
+
+template <typename SampleType>
+struct VectorKernelFunctions
+{
+    // Saturation curve over already driven samples, in place
+    void (*shape)(SampleType* data, int numSamples, const ShaperCoefficients<SampleType>& curve) noexcept;
+
+    // Catmull-Rom lookup of each driven sample in a pair of table slices.
+    // Returns whether any input lies beyond the table; the caller replaces
+    // those outputs.
+    bool (*shapeTable)(const SampleType* input, SampleType* output, int numSamples, const TableSlices& slices) noexcept;
+
+    // output = floor(input * levels) / levels
+    void (*quantize)(const SampleType* input, SampleType* output, int numSamples, SampleType levels) noexcept;
+    void (*quantizeRamp)(const SampleType* input, SampleType* output, int numSamples, const SampleType* levels) noexcept;
+
+    // mid = (L + R) * 0.5 * (1 - ratio), side = (L - R) * 0.5 * ratio, in place
+    void (*midSideEncode)(SampleType* left, SampleType* right, int numSamples, SampleType ratio) noexcept;
+    void (*midSideEncodeRamp)(SampleType* left, SampleType* right, int numSamples, const SampleType* ratio) noexcept;
+
+    // left = mid + side, right = mid - side, in place
+    void (*midSideDecode)(SampleType* mid, SampleType* side, int numSamples) noexcept;
+
+    // clean = clean * (1 - mix) + wet * mix * 0.5
+    void (*mix)(SampleType* clean, const SampleType* wet, int numSamples, SampleType mix) noexcept;
+    void (*mixRamp)(SampleType* clean, const SampleType* wet, int numSamples, const SampleType* mix) noexcept;
+
+    // clean += wet * mix * 0.5
+    void (*addWet)(SampleType* clean, const SampleType* wet, int numSamples, SampleType mix) noexcept;
+    void (*addWetRamp)(SampleType* clean, const SampleType* wet, int numSamples, const SampleType* mix) noexcept;
+};
+
+// Defined in VectorKernelsBaseline.cpp, VectorKernelsAVX2.cpp and
+// VectorKernelsAVX512.cpp. Off x86 the AVX functions return the baseline
+// kernels.
+template <typename SampleType>
+const VectorKernelFunctions<SampleType>& getBaselineKernelFunctions() noexcept;
+
+template <typename SampleType>
+const VectorKernelFunctions<SampleType>& getAvx2KernelFunctions() noexcept;
+
+template <typename SampleType>
+const VectorKernelFunctions<SampleType>& getAvx512KernelFunctions() noexcept;
+
+template <> const VectorKernelFunctions<float>& getBaselineKernelFunctions<float>() noexcept;
+template <> const VectorKernelFunctions<double>& getBaselineKernelFunctions<double>() noexcept;
+template <> const VectorKernelFunctions<float>& getAvx2KernelFunctions<float>() noexcept;
+template <> const VectorKernelFunctions<double>& getAvx2KernelFunctions<double>() noexcept;
+template <> const VectorKernelFunctions<float>& getAvx512KernelFunctions<float>() noexcept;
+template <> const VectorKernelFunctions<double>& getAvx512KernelFunctions<double>() noexcept;
@@ -0,0 +1,240 @@
+#include "VectorKernels.h"
+
+namespace
+{
+    using InstructionSet = VectorKernels::InstructionSet;
+
+    // -1 = follow the environment variable or detection
+    std::atomic<int> forcedInstructionSet { -1 };
+
+    const char* const instructionSetNames[] = { "reference", "baseline", "avx2", "avx512" };
+
+    int getEnvironmentInstructionSet()
+    {
+        const auto requested = juce::SystemStats::getEnvironmentVariable("ANTSDISTSAT_KERNELS", {}).trim().toLowerCase();
+
+        for (int set = 0; set < (int)juce::numElementsInArray(instructionSetNames); ++set)
+            if (requested == instructionSetNames[set])
+                return set;
+
+        return -1;
+    }
+
+    // Reference kernels: plain scalar code with the standard library maths
+    template <typename SampleType>
+    void shapeReference(SampleType* data, int numSamples, const ShaperCoefficients<SampleType>& coefficients) noexcept
+    {
+        const ShaperCurve<SampleType> curve(coefficients.saturation);
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = curve(data[i]);
+    }
+
+    template <typename SampleType>
+    bool shapeTableReference(const SampleType* input, SampleType* output, int numSamples,
+                             const VectorKernels::TableSlices& slices) noexcept
+    {
+        bool outOfRange = false;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // The curve is odd, so only |driven| is looked up
+            const SampleType magnitude = std::abs(input[i]);
+            const SampleType position = juce::jmin((SampleType)slices.range, magnitude) * (SampleType)slices.pointsPerUnit + SampleType(1);
+            const int index = (int)position;
+            const SampleType t = position - (SampleType)index;
+
+            const float* a = slices.lower + index - 1;
+            const float* b = slices.upper + index - 1;
+            const SampleType weight = slices.weight;
+
+            const SampleType p0 = a[0] + weight * (b[0] - a[0]);
+            const SampleType p1 = a[1] + weight * (b[1] - a[1]);
+            const SampleType p2 = a[2] + weight * (b[2] - a[2]);
+            const SampleType p3 = a[3] + weight * (b[3] - a[3]);
+
+            // Catmull-Rom
+            const SampleType shaped = p1 + SampleType(0.5) * t
+                                         * (p2 - p0 + t * (SampleType(2) * p0 - SampleType(5) * p1 + SampleType(4) * p2 - p3
+                                                           + t * (SampleType(3) * (p1 - p2) + p3 - p0)));
+
+            output[i] = std::copysign(shaped, input[i]);
+            outOfRange = outOfRange || magnitude >= (SampleType)slices.range;
+        }
+
+        return outOfRange;
+    }
+
+    template <typename SampleType>
+    void quantizeReference(const SampleType* input, SampleType* output, int numSamples, SampleType levels) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = std::floor(input[i] * levels) / levels;
+    }
+
+    template <typename SampleType>
+    void quantizeRampReference(const SampleType* input, SampleType* output, int numSamples, const SampleType* levels) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = std::floor(input[i] * levels[i]) / levels[i];
+    }
+
+    template <typename SampleType>
+    void midSideEncodeReference(SampleType* left, SampleType* right, int numSamples, SampleType ratio) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType l = left[i];
+            const SampleType r = right[i];
+            left[i] = (l + r) * SampleType(0.5) * (SampleType(1) - ratio);
+            right[i] = (l - r) * SampleType(0.5) * ratio;
+        }
+    }
+
+    template <typename SampleType>
+    void midSideEncodeRampReference(SampleType* left, SampleType* right, int numSamples, const SampleType* ratio) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType l = left[i];
+            const SampleType r = right[i];
+            left[i] = (l + r) * SampleType(0.5) * (SampleType(1) - ratio[i]);
+            right[i] = (l - r) * SampleType(0.5) * ratio[i];
+        }
+    }
+
+    template <typename SampleType>
+    void midSideDecodeReference(SampleType* mid, SampleType* side, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType m = mid[i];
+            const SampleType s = side[i];
+            mid[i] = m + s;
+            side[i] = m - s;
+        }
+    }
+
+    template <typename SampleType>
+    void mixReference(SampleType* clean, const SampleType* wet, int numSamples, SampleType mix) noexcept
+    {
+        juce::FloatVectorOperations::multiply(clean, SampleType(1) - mix, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(clean, wet, mix * SampleType(0.5), numSamples);
+    }
+
+    template <typename SampleType>
+    void mixRampReference(SampleType* clean, const SampleType* wet, int numSamples, const SampleType* mix) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            clean[i] = clean[i] * (SampleType(1) - mix[i]) + wet[i] * (mix[i] * SampleType(0.5));
+    }
+
+    template <typename SampleType>
+    void addWetReference(SampleType* clean, const SampleType* wet, int numSamples, SampleType mix) noexcept
+    {
+        juce::FloatVectorOperations::addWithMultiply(clean, wet, mix * SampleType(0.5), numSamples);
+    }
+
+    template <typename SampleType>
+    void addWetRampReference(SampleType* clean, const SampleType* wet, int numSamples, const SampleType* mix) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            clean[i] += wet[i] * (mix[i] * SampleType(0.5));
+    }
+
+    template <typename SampleType>
+    const VectorKernels::Table<SampleType> referenceKernels
+    {
+        {
+            shapeReference<SampleType>,
+            shapeTableReference<SampleType>,
+            quantizeReference<SampleType>,
+            quantizeRampReference<SampleType>,
+            midSideEncodeReference<SampleType>,
+            midSideEncodeRampReference<SampleType>,
+            midSideDecodeReference<SampleType>,
+            mixReference<SampleType>,
+            mixRampReference<SampleType>,
+            addWetReference<SampleType>,
+            addWetRampReference<SampleType>
+        },
+        InstructionSet::reference
+    };
+}
+
+VectorKernels::InstructionSet VectorKernels::getDetectedInstructionSet() noexcept
+{
+   #if JUCE_INTEL
+    // /arch:AVX512 lets the compiler use the F, CD, BW, DQ and VL subsets
+    if (juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512CD() && juce::SystemStats::hasAVX512BW()
+        && juce::SystemStats::hasAVX512DQ() && juce::SystemStats::hasAVX512VL())
+        return InstructionSet::avx512;
+
+    if (juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3())
+        return InstructionSet::avx2;
+   #endif
+
+    return InstructionSet::baseline;
+}
+
+VectorKernels::InstructionSet VectorKernels::getActiveInstructionSet() noexcept
+{
+    static const InstructionSet detected = getDetectedInstructionSet();
+    static const int environment = getEnvironmentInstructionSet();
+
+    const int forced = forcedInstructionSet.load();
+    const int requested = forced >= 0 ? forced : environment;
+
+    if (requested < 0)
+        return detected;
+
+    return static_cast<InstructionSet>(juce::jmin(requested, (int)detected));
+}
+
+void VectorKernels::setInstructionSet(InstructionSet set) noexcept
+{
+    forcedInstructionSet = (int)set;
+}
+
+void VectorKernels::resetInstructionSet() noexcept
+{
+    forcedInstructionSet = -1;
+}
+
+const char* VectorKernels::getName(InstructionSet set) noexcept
+{
+    return instructionSetNames[(int)set];
+}
+
+template <typename SampleType>
+const VectorKernels::Table<SampleType>& VectorKernels::get() noexcept
+{
+    return get<SampleType>(getActiveInstructionSet());
+}
+
+template <typename SampleType>
+const VectorKernels::Table<SampleType>& VectorKernels::get(InstructionSet set) noexcept
+{
+    // Never hand out a set this CPU cannot run
+    set = static_cast<InstructionSet>(juce::jmin((int)set, (int)getDetectedInstructionSet()));
+
+    // The vector sets hand back plain function tables; tag each once
+    static const Table<SampleType> baseline { getBaselineKernelFunctions<SampleType>(), InstructionSet::baseline };
+    static const Table<SampleType> avx2 { getAvx2KernelFunctions<SampleType>(), InstructionSet::avx2 };
+    static const Table<SampleType> avx512 { getAvx512KernelFunctions<SampleType>(), InstructionSet::avx512 };
+
+    switch (set)
+    {
+        case InstructionSet::avx512:    return avx512;
+        case InstructionSet::avx2:      return avx2;
+        case InstructionSet::baseline:  return baseline;
+        case InstructionSet::reference: break;
+    }
+
+    return referenceKernels<SampleType>;
+}
+
+template const VectorKernels::Table<float>& VectorKernels::get<float>() noexcept;
+template const VectorKernels::Table<double>& VectorKernels::get<double>() noexcept;
+template const VectorKernels::Table<float>& VectorKernels::get<float>(InstructionSet) noexcept;
+template const VectorKernels::Table<double>& VectorKernels::get<double>(InstructionSet) noexcept;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ShaperCurve.h"
+#include "VectorKernelFunctions.h"
+
+// The block kernels on the hot path (shaper, table shaper, quantizer, M/S,
+// mix), built once per instruction set and sample type.
+//
+// The reference set is plain scalar code using the standard library maths and
+// defines the sound. The vector sets compile one shared source,
+// VectorKernelsImpl.h, for the baseline target (SSE2 on x64) and for AVX2 and
+// AVX-512 in translation units with their own compiler flags, which see only
+// VectorKernelFunctions.h and hand back plain function tables. Those loops use
+// polynomial sin/tanh instead of library calls so they vectorise, and agree
+// with the reference to within shaperTolerance; the quantizer, M/S and mix
+// kernels differ at most by FMA contraction. The table shaper interpolates in
+// float in the vector sets, so for double data it differs from the reference
+// by float rounding, well inside the table's own error. The double tables use
+// longer polynomials, accurate to about 1e-15.
+//
+// get<SampleType>() returns the widest set the CPU supports. A set can be
+// forced with setInstructionSet() or the ANTSDISTSAT_KERNELS environment
+// variable (reference, baseline, avx2, avx512); requests the CPU cannot run
+// fall back to the detected set. The engine picks up the choice in prepare().
+struct VectorKernels
+{
+    // Ordered by width, so a request is capped at the detected set
+    enum class InstructionSet
+    {
+        reference = 0,
+        baseline,
+        avx2,
+        avx512
+    };
+
+    template <typename SampleType>
+    struct Table;
+
+    using TableSlices = ::TableSlices;
+
+    template <typename SampleType>
+    static const Table<SampleType>& get() noexcept;
+
+    template <typename SampleType>
+    static const Table<SampleType>& get(InstructionSet set) noexcept;
+
+    static InstructionSet getDetectedInstructionSet() noexcept;
+    static InstructionSet getActiveInstructionSet() noexcept;
+
+    // Forces a set for testing; call resetInstructionSet() to go back to detection
+    static void setInstructionSet(InstructionSet set) noexcept;
+    static void resetInstructionSet() noexcept;
+
+    static const char* getName(InstructionSet set) noexcept;
+
+    // Largest absolute difference of the vector shaper from the reference over
+    // the full drive range
+    static constexpr float shaperTolerance = 1.0e-5f;
+};
+
+// One set's kernels, tagged with the set they were built for
+template <typename SampleType>
+struct VectorKernels::Table : VectorKernelFunctions<SampleType>
+{
+    InstructionSet instructionSet;
+};
@@ -0,0 +1,47 @@
+#include "VectorKernelFunctions.h"
+#include <cstring>
+
+// MSVC builds this file with /arch:AVX512 (the avx512 compiler flag scheme in
+// the .jucer), which covers the whole file, so it includes nothing with
+// inline code but the kernels themselves: no JUCE and no ShaperCurve.h.
+// GCC and Clang get the same target from a pragma around the kernels only.
+// GCC also needs no-trapping-math to turn the selects into blends (the
+// kernels never read the FP status flags) and the full vectoriser cost
+// model, which -O2 leaves out.
+#if ANTSDISTSAT_KERNELS_INTEL && defined (__clang__)
+ #pragma clang attribute push (__attribute__((target("avx512f,avx512cd,avx512bw,avx512dq,avx512vl,avx2,fma"))), apply_to = function)
+#elif ANTSDISTSAT_KERNELS_INTEL && defined (__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target ("avx512f,avx512cd,avx512bw,avx512dq,avx512vl,avx2,fma")
+ #pragma GCC optimize ("no-trapping-math", "tree-vectorize", "vect-cost-model=dynamic")
+#endif
+
+#include "VectorKernelsImpl.h"
+
+#if ANTSDISTSAT_KERNELS_INTEL && defined (__clang__)
+ #pragma clang attribute pop
+#elif ANTSDISTSAT_KERNELS_INTEL && defined (__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+template <>
+const VectorKernelFunctions<float>& getAvx512KernelFunctions<float>() noexcept
+{
+   #if ANTSDISTSAT_KERNELS_INTEL
+    static constexpr auto kernels = makeVectorKernels<float>();
+    return kernels;
+   #else
+    return getBaselineKernelFunctions<float>();
+   #endif
+}
+
+template <>
+const VectorKernelFunctions<double>& getAvx512KernelFunctions<double>() noexcept
+{
+   #if ANTSDISTSAT_KERNELS_INTEL
+    static constexpr auto kernels = makeVectorKernels<double>();
+    return kernels;
+   #else
+    return getBaselineKernelFunctions<double>();
+   #endif
+}
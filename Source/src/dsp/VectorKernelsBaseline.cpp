@@ -0,0 +1,32 @@
+#include "VectorKernelFunctions.h"
+#include <cstring>
+
+// Built with the project's default target: SSE2 on x64. Like the AVX units
+// it sees only the kernels, so the three compile the same code. GCC only
+// turns the selects in the kernels into blends with no-trapping-math (the
+// kernels never read the FP status flags), and -O2 leaves out the full
+// vectoriser cost model.
+#if defined (__GNUC__) && ! defined (__clang__)
+ #pragma GCC push_options
+ #pragma GCC optimize ("no-trapping-math", "tree-vectorize", "vect-cost-model=dynamic")
+#endif
+
+#include "VectorKernelsImpl.h"
+
+#if defined (__GNUC__) && ! defined (__clang__)
+ #pragma GCC pop_options
+#endif
+
+template <>
+const VectorKernelFunctions<float>& getBaselineKernelFunctions<float>() noexcept
+{
+    static constexpr auto kernels = makeVectorKernels<float>();
+    return kernels;
+}
+
+template <>
+const VectorKernelFunctions<double>& getBaselineKernelFunctions<double>() noexcept
+{
+    static constexpr auto kernels = makeVectorKernels<double>();
+    return kernels;
+}
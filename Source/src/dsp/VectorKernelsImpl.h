@@ -0,0 +1,362 @@
+#pragma once
+
+// Vector kernel bodies, included only by the per-instruction-set translation
+// units after they have set their target. Everything here has internal
+// linkage and calls no library functions, and the units include nothing but
+// VectorKernelFunctions.h and <cstring> besides, so nothing compiled for a
+// wider instruction set can be merged into code that runs on older CPUs.
+//
+// The loops are plain float or double maths with selects instead of
+// branches; sin and tanh are polynomial so the compiler can vectorise the
+// shaper as well. The double polynomials are longer, so both widths are
+// accurate to a few units in the last place of their own type.
+
+namespace
+{
+    template <typename SampleType>
+    struct KernelConstants;
+
+    template <>
+    struct KernelConstants<float>
+    {
+        using Bits = std::int32_t;
+        static constexpr int mantissaBits = 23;
+        static constexpr int exponentBias = 127;
+
+        // Taylor series of 2^f - 1 on [-0.5, 0.5] without the constant term,
+        // relative error below 1e-8
+        static constexpr float exp2Coefficients[] = { 0.693147181f, 0.240226507f, 0.0555041087f, 0.00961812911f,
+                                                      0.00133335581f, 0.000154035304f, 0.0000152527338f };
+
+        // Taylor series of sin(r) / r in r^2 to r^10, error below 6e-8 on [-pi/2, pi/2]
+        static constexpr float sinCoefficients[] = { 1.0f, -1.66666667e-1f, 8.33333333e-3f, -1.98412698e-4f,
+                                                     2.75573192e-6f, -2.50521084e-8f };
+
+        // 2*pi split in two, so the reduction stays exact at high drive
+        static constexpr float twoPiHigh = 6.28125f;
+        static constexpr float twoPiLow = 1.93530718e-3f;
+
+        // tanh is +/-1 in float beyond this
+        static constexpr float tanhLimit = 9.0f;
+
+        static constexpr float pi = 3.14159265358979323846f;
+        static constexpr float twoPi = 6.28318530717958647693f;
+    };
+
+    template <>
+    struct KernelConstants<double>
+    {
+        using Bits = std::int64_t;
+        static constexpr int mantissaBits = 52;
+        static constexpr int exponentBias = 1023;
+
+        // Same series to f^13, relative error below 1e-16
+        static constexpr double exp2Coefficients[] = { 0.6931471805599453, 0.2402265069591007, 0.055504108664821576,
+                                                       0.009618129107628477, 0.0013333558146428441, 0.00015403530393381606,
+                                                       1.5252733804059838e-05, 1.3215486790144305e-06, 1.0178086009239696e-07,
+                                                       7.054911620801121e-09, 4.44553827187081e-10, 2.5678435993488196e-11,
+                                                       1.3691488853904124e-12 };
+
+        // Same series to r^20, error below 2e-18 on [-pi/2, pi/2]
+        static constexpr double sinCoefficients[] = { 1.0, -0.16666666666666666, 0.008333333333333333,
+                                                      -0.0001984126984126984, 2.7557319223985893e-06,
+                                                      -2.505210838544172e-08, 1.6059043836821613e-10,
+                                                      -7.647163731819816e-13, 2.8114572543455206e-15,
+                                                      -8.22063524662433e-18, 1.9572941063391263e-20 };
+
+        static constexpr double twoPiHigh = 6.28125;
+        static constexpr double twoPiLow = 0.001935307179586232;
+
+        static constexpr double tanhLimit = 20.0;
+
+        static constexpr double pi = 3.14159265358979323846;
+        static constexpr double twoPi = 6.28318530717958647693;
+    };
+
+    // c[0] + x * (c[1] + x * (c[2] + ...)), expanded at compile time so the
+    // calling loop stays a single basic block
+    template <std::size_t index = 0, typename SampleType, std::size_t numCoefficients>
+    inline SampleType evaluatePolynomial(SampleType x, const SampleType (&coefficients)[numCoefficients]) noexcept
+    {
+        if constexpr (index + 1 == numCoefficients)
+            return coefficients[index];
+        else
+            return coefficients[index] + x * evaluatePolynomial<index + 1>(x, coefficients);
+    }
+
+    template <typename SampleType>
+    inline SampleType minimum(SampleType a, SampleType b) noexcept { return b < a ? b : a; }
+
+    template <typename SampleType>
+    inline SampleType maximum(SampleType a, SampleType b) noexcept { return a < b ? b : a; }
+
+    template <typename SampleType>
+    inline SampleType absolute(SampleType x) noexcept
+    {
+        return maximum(x, -x);
+    }
+
+    template <typename SampleType>
+    inline int roundToNearest(SampleType x) noexcept
+    {
+        const SampleType half = x < SampleType(0) ? SampleType(-0.5) : SampleType(0.5);
+        return static_cast<int>(x + half);
+    }
+
+    // Exact floor for |x| < 2^30, which covers any gated sample times 2^16 levels
+    template <typename SampleType>
+    inline SampleType floorValue(SampleType x) noexcept
+    {
+        constexpr SampleType limit = SampleType(1073741824);
+        const SampleType clamped = maximum(-limit, minimum(x, limit));
+        const int truncated = static_cast<int>(clamped);
+        return static_cast<SampleType>(truncated - (static_cast<SampleType>(truncated) > clamped ? 1 : 0));
+    }
+
+    // 2^x - 1 for |x| below the exponent range, accurate near zero
+    template <typename SampleType>
+    inline SampleType exp2MinusOne(SampleType x) noexcept
+    {
+        using Constants = KernelConstants<SampleType>;
+        using Bits = typename Constants::Bits;
+
+        const int n = roundToNearest(x);
+        const SampleType f = x - static_cast<SampleType>(n);
+        const SampleType q = f * evaluatePolynomial(f, Constants::exp2Coefficients);
+
+        const Bits bits = static_cast<Bits>(n + Constants::exponentBias) << Constants::mantissaBits;
+        SampleType scale;
+        std::memcpy(&scale, &bits, sizeof(SampleType));
+        return scale * q + (scale - SampleType(1));
+    }
+
+    template <typename SampleType>
+    inline SampleType sinValue(SampleType x) noexcept
+    {
+        using Constants = KernelConstants<SampleType>;
+        constexpr SampleType pi = Constants::pi;
+
+        // Reduce to [-pi, pi], then fold into [-pi/2, pi/2]
+        const SampleType k = static_cast<SampleType>(roundToNearest(x * (SampleType(1) / Constants::twoPi)));
+        const SampleType reduced = (x - k * Constants::twoPiHigh) - k * Constants::twoPiLow;
+        const SampleType upperFolded = minimum(reduced, pi - reduced);
+        const SampleType r = maximum(upperFolded, -pi - upperFolded);
+
+        return r * evaluatePolynomial(r * r, Constants::sinCoefficients);
+    }
+
+    template <typename SampleType>
+    inline SampleType tanhValue(SampleType x) noexcept
+    {
+        // tanh(x) = -m / (2 + m) with m = exp(-2x) - 1, which is odd and has no
+        // cancellation near zero
+        constexpr SampleType limit = KernelConstants<SampleType>::tanhLimit;
+        constexpr SampleType minusTwoOverLn2 = SampleType(-2.8853900817779268);
+
+        const SampleType clamped = maximum(-limit, minimum(x, limit));
+        const SampleType m = exp2MinusOne(clamped * minusTwoOverLn2);
+        return -m / (SampleType(2) + m);
+    }
+
+    // Same operations as ShaperCurve<SampleType>::operator()
+    template <typename SampleType>
+    void shapeVector(SampleType* data, int numSamples, const ShaperCoefficients<SampleType>& curve) noexcept
+    {
+        constexpr SampleType twoPi = KernelConstants<SampleType>::twoPi;
+        constexpr SampleType threePi = KernelConstants<SampleType>::pi * SampleType(3);
+        constexpr SampleType fourPi = KernelConstants<SampleType>::twoPi * SampleType(2);
+        constexpr SampleType downScale = ShaperCoefficients<SampleType>::downScale;
+
+        const SampleType saturation = curve.saturation;
+        const SampleType clipGain = curve.clipGain;
+        const SampleType shapeGain = curve.shapeGain;
+        const SampleType shapeKnee = curve.shapeKnee;
+        const SampleType dryGain = curve.dryGain;
+        const SampleType wetGain = curve.wetGain;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType driven = data[i];
+            const SampleType scaled = driven * downScale;
+            const SampleType scaled2 = scaled * scaled;
+            const SampleType scaled3 = scaled2 * scaled;
+
+            const SampleType clipped = tanhValue(scaled * clipGain) + SampleType(0.3) * scaled3
+                                     - SampleType(0.1) * scaled3 * scaled2;
+
+            const SampleType harmonics = (sinValue(driven * twoPi) * SampleType(0.12)
+                                        + sinValue(driven * threePi) * SampleType(0.07)
+                                        + sinValue(driven * fourPi) * SampleType(0.03)) * saturation;
+
+            const SampleType shaped = clipped + harmonics;
+            const SampleType distorted = (shaped * shapeGain) / (SampleType(1) + absolute(shaped * shapeKnee));
+
+            data[i] = dryGain * driven + wetGain * distorted;
+        }
+    }
+
+    // Same operations as the reference, in three passes per block: positions,
+    // then the gathers and the Catmull-Rom blend, then the sign. The compiler
+    // does not vectorise a gather whose index comes from float maths in the
+    // same loop, nor one that mixes float and double lanes, but vectorises
+    // each pass on its own. The table is float, so the lookup runs in float
+    // for double data too
+    template <typename SampleType>
+    bool shapeTableVector(const SampleType* input, SampleType* output, int numSamples,
+                          const TableSlices& slices) noexcept
+    {
+        constexpr int passSize = 64;
+        int indices[passSize];
+        float fractions[passSize];
+
+        const float* lower = slices.lower;
+        const float* upper = slices.upper;
+        const float weight = slices.weight;
+        const float positionScale = slices.pointsPerUnit;
+        const float range = slices.range;
+
+        int outOfRange = 0;
+
+        for (int start = 0; start < numSamples; start += passSize)
+        {
+            const int count = numSamples - start < passSize ? numSamples - start : passSize;
+            const SampleType* in = input + start;
+            SampleType* out = output + start;
+
+            for (int i = 0; i < count; ++i)
+            {
+                const float magnitude = absolute(static_cast<float>(in[i]));
+                const float position = minimum(range, magnitude) * positionScale + 1.0f;
+                indices[i] = static_cast<int>(position);
+                fractions[i] = position - static_cast<float>(indices[i]);
+                outOfRange |= magnitude >= range ? 1 : 0;
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                const int index = indices[i];
+                const float t = fractions[i];
+
+                const float p0 = lower[index - 1] + weight * (upper[index - 1] - lower[index - 1]);
+                const float p1 = lower[index] + weight * (upper[index] - lower[index]);
+                const float p2 = lower[index + 1] + weight * (upper[index + 1] - lower[index + 1]);
+                const float p3 = lower[index + 2] + weight * (upper[index + 2] - lower[index + 2]);
+
+                const float shaped = p1 + 0.5f * t
+                                        * (p2 - p0 + t * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3
+                                                          + t * (3.0f * (p1 - p2) + p3 - p0)));
+
+                fractions[i] = shaped;
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                const SampleType shaped = fractions[i];
+                out[i] = in[i] < SampleType(0) ? -shaped : shaped;
+            }
+        }
+
+        return outOfRange != 0;
+    }
+
+    template <typename SampleType>
+    void quantizeVector(const SampleType* input, SampleType* output, int numSamples, SampleType levels) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = floorValue(input[i] * levels) / levels;
+    }
+
+    template <typename SampleType>
+    void quantizeRampVector(const SampleType* input, SampleType* output, int numSamples, const SampleType* levels) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = floorValue(input[i] * levels[i]) / levels[i];
+    }
+
+    template <typename SampleType>
+    void midSideEncodeVector(SampleType* left, SampleType* right, int numSamples, SampleType ratio) noexcept
+    {
+        const SampleType midGain = SampleType(1) - ratio;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType l = left[i];
+            const SampleType r = right[i];
+            left[i] = (l + r) * SampleType(0.5) * midGain;
+            right[i] = (l - r) * SampleType(0.5) * ratio;
+        }
+    }
+
+    template <typename SampleType>
+    void midSideEncodeRampVector(SampleType* left, SampleType* right, int numSamples, const SampleType* ratio) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType l = left[i];
+            const SampleType r = right[i];
+            left[i] = (l + r) * SampleType(0.5) * (SampleType(1) - ratio[i]);
+            right[i] = (l - r) * SampleType(0.5) * ratio[i];
+        }
+    }
+
+    template <typename SampleType>
+    void midSideDecodeVector(SampleType* mid, SampleType* side, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType m = mid[i];
+            const SampleType s = side[i];
+            mid[i] = m + s;
+            side[i] = m - s;
+        }
+    }
+
+    template <typename SampleType>
+    void mixVector(SampleType* clean, const SampleType* wet, int numSamples, SampleType mix) noexcept
+    {
+        const SampleType dryGain = SampleType(1) - mix;
+        const SampleType wetGain = mix * SampleType(0.5);
+
+        for (int i = 0; i < numSamples; ++i)
+            clean[i] = clean[i] * dryGain + wet[i] * wetGain;
+    }
+
+    template <typename SampleType>
+    void mixRampVector(SampleType* clean, const SampleType* wet, int numSamples, const SampleType* mix) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            clean[i] = clean[i] * (SampleType(1) - mix[i]) + wet[i] * (mix[i] * SampleType(0.5));
+    }
+
+    template <typename SampleType>
+    void addWetVector(SampleType* clean, const SampleType* wet, int numSamples, SampleType mix) noexcept
+    {
+        const SampleType wetGain = mix * SampleType(0.5);
+
+        for (int i = 0; i < numSamples; ++i)
+            clean[i] += wet[i] * wetGain;
+    }
+
+    template <typename SampleType>
+    void addWetRampVector(SampleType* clean, const SampleType* wet, int numSamples, const SampleType* mix) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            clean[i] += wet[i] * (mix[i] * SampleType(0.5));
+    }
+
+    template <typename SampleType>
+    constexpr VectorKernelFunctions<SampleType> makeVectorKernels() noexcept
+    {
+        return { shapeVector<SampleType>,
+                 shapeTableVector<SampleType>,
+                 quantizeVector<SampleType>,
+                 quantizeRampVector<SampleType>,
+                 midSideEncodeVector<SampleType>,
+                 midSideEncodeRampVector<SampleType>,
+                 midSideDecodeVector<SampleType>,
+                 mixVector<SampleType>,
+                 mixRampVector<SampleType>,
+                 addWetVector<SampleType>,
+                 addWetRampVector<SampleType> };
+    }
+}